@@ -4,103 +4,432 @@
 #define LOG_LVL LOG_LVL_WARNING
 #include <ulog.h>
 
+#define EBUS_RESP_EXPIRE_BATCH      (8)     //单轮回调的最大超时项数量
+
+#define EBUS_EXEC_STATE_IDLE        (0)     //节点没有待执行的消息
+#define EBUS_EXEC_STATE_READY       (1)     //节点位于就绪队列
+#define EBUS_EXEC_STATE_RUNNING     (2)     //节点正在某个工作线程上执行
+
+#define EBUS_EXEC_LINK_NONE         (0)     //不在就绪队列
+#define EBUS_EXEC_LINK_NORMAL       (1)     //按先后排在就绪队列尾部
+#define EBUS_EXEC_LINK_URGENT       (2)     //按截止时间排在就绪队列头部
+
+#define EBUS_DEADLINE_BEFORE(a, b)  ((rt_int32_t)((a) - (b)) < 0)  //截止时刻a早于b，处理tick回绕
+
+#define EBUS_TIMER_WHEEL_MASK       (EBUS_TIMER_WHEEL_SIZE - 1)
+#define EBUS_TIMER_HANDLE_MAKE(idx, gen)    ((uint16_t)(((gen) << 8) | (idx)))
+#define EBUS_TIMER_HANDLE_IDX(h)            ((h) & 0xFF)
+#define EBUS_TIMER_HANDLE_GEN(h)            (((h) >> 8) & 0xFF)
+
+#ifdef RT_USING_TIMER_SOFT
+#define EBUS_TIMER_FLAG             (RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_SOFT_TIMER)
+#else
+#define EBUS_TIMER_FLAG             (RT_TIMER_FLAG_PERIODIC)
+#endif
+
+/* 节点与缓冲区按缓存行对齐分配，并占满最后一个缓存行，相邻节点不共享缓存行 */
+#if EBUS_CACHE_LINE_SIZE > RT_ALIGN_SIZE
+#define EBUS_NODE_MALLOC(size)      rt_malloc_align(RT_ALIGN((size), EBUS_CACHE_LINE_SIZE), EBUS_CACHE_LINE_SIZE)
+#define EBUS_NODE_FREE(ptr)         rt_free_align(ptr)
+#else
+#define EBUS_NODE_MALLOC(size)      rt_malloc(size)
+#define EBUS_NODE_FREE(ptr)         rt_free(ptr)
+#endif
+
+#ifdef RT_USING_SMP
+#define EBUS_CPU_SELF()             ((uint8_t)rt_hw_cpu_id())
+#else
+#define EBUS_CPU_SELF()             (0)
+#endif
+
 static sEbus_t g_ebus_ = { 0 };
+static sEbusExec_t g_ebus_exec_ = { 0 };
+static sEbusTimerWheel_t g_ebus_tmr_ = { 0 };
+
+static void EbusIsrRingDrain(void);
+static void EbusTimerTick(void *parameter);
+static void EbusTimerCancelNode(sEbusNode_t *node);
+static rt_bool_t EbusExecInSelf(sEbusNode_t *node);
+
+/**
+ * @description: 尝试获取注册表读锁，不阻塞，可在中断中调用；只写本核的读者计数，各核读者互不干扰
+ * @return {*} 有写者时返回RT_FALSE
+ */
+static rt_bool_t EbusReadTryLock(void)
+{
+    sEbusRwLock_t *lock = &g_ebus_.bus_lock;
+
+    if (rt_atomic_load(&lock->writer))
+    {
+        return RT_FALSE;
+    }
+    // 进入与退让使用同一个计数，写者不会只看到退让的减一而漏算临界区内的读者
+    volatile rt_atomic_t *readers = &lock->readers[EBUS_CPU_SELF()].cnt;
+    rt_atomic_add(readers, 1);
+    if (!rt_atomic_load(&lock->writer))
+    {
+        return RT_TRUE;
+    }
+    // 与写者竞争失败，退出并唤醒写者重新统计
+    rt_atomic_sub(readers, 1);
+    rt_sem_release(&lock->drain_sem);
+    return RT_FALSE;
+}
 
 /**
- * @description: 获取流水号
+ * @description: 注册表读锁，无写者时只有一次原子加
  * @return {*}
  */
-static uint16_t EbusGetSn(void)
+static void EbusReadLock(void)
 {
-    rt_mutex_take(g_ebus_.bus_mutex, RT_WAITING_FOREVER);
-    ++g_ebus_.sn;
-    rt_mutex_release(g_ebus_.bus_mutex);
-    return g_ebus_.sn;
+    sEbusRwLock_t *lock = &g_ebus_.bus_lock;
+
+    while (!EbusReadTryLock())
+    {
+        // 在写者互斥量上排队，阻塞期间写者继承本线程优先级
+        rt_mutex_take(&lock->writer_mutex, RT_WAITING_FOREVER);
+        rt_mutex_release(&lock->writer_mutex);
+    }
 }
 
 /**
- * @description: 根据名称查找节点
+ * @description: 注册表读解锁
+ * @return {*}
+ */
+static void EbusReadUnlock(void)
+{
+    sEbusRwLock_t *lock = &g_ebus_.bus_lock;
+
+    // 线程可能已迁移到其他核，计数单核可为负，总和仍是临界区内的读者数量
+    rt_atomic_sub(&lock->readers[EBUS_CPU_SELF()].cnt, 1);
+    if (rt_atomic_load(&lock->writer))
+    {
+        rt_sem_release(&lock->drain_sem);
+    }
+}
+
+/**
+ * @description: 统计各核读者计数之和，写者置位后调用
+ * @return {*}
+ */
+static rt_atomic_t EbusReaderCount(void)
+{
+    rt_atomic_t sum = 0;
+
+    for (int i = 0; i < EBUS_CPU_NUM; i++)
+    {
+        sum += rt_atomic_load(&g_ebus_.bus_lock.readers[i].cnt);
+    }
+    return sum;
+}
+
+/**
+ * @description: 注册表写锁，等待已进入的读者全部退出
+ * @return {*}
+ */
+static void EbusWriteLock(void)
+{
+    sEbusRwLock_t *lock = &g_ebus_.bus_lock;
+
+    rt_mutex_take(&lock->writer_mutex, RT_WAITING_FOREVER);
+    rt_sem_control(&lock->drain_sem, RT_IPC_CMD_RESET, (void *)0);
+    rt_atomic_store(&lock->writer, 1);
+    while (EbusReaderCount() > 0)
+    {
+        rt_sem_take(&lock->drain_sem, RT_WAITING_FOREVER);
+    }
+}
+
+/**
+ * @description: 注册表写解锁
+ * @return {*}
+ */
+static void EbusWriteUnlock(void)
+{
+    sEbusRwLock_t *lock = &g_ebus_.bus_lock;
+
+    rt_atomic_store(&lock->writer, 0);
+    rt_mutex_release(&lock->writer_mutex);
+
+    // 转发写锁期间中断暂存的消息
+    EbusIsrRingDrain();
+}
+
+/**
+ * @description: 唤醒登记在信号量上的全部等待者，等待者被唤醒后重新检查条件，多余的计数只造成一次空检查
+ * @param {rt_atomic_t} *wait 等待者登记数量
+ * @param {rt_sem_t} sem
+ * @return {*}
+ */
+static void EbusWakeWaiters(volatile rt_atomic_t *wait, rt_sem_t sem)
+{
+    rt_atomic_t n = rt_atomic_exchange(wait, 0);
+    while (n-- > 0)
+    {
+        rt_sem_release(sem);
+    }
+}
+
+/**
+ * @description: 分配源节点的序列号，各节点独立计数，只有同一节点的并发发送者才竞争
+ * @param {sEbusNode_t} *node 源节点
+ * @return {*}
+ */
+static uint32_t EbusGetSn(sEbusNode_t *node)
+{
+    return (uint32_t)(rt_atomic_add(&node->tx_sn, 1) + 1);
+}
+
+/**
+ * @description: 计算节点名称散列值
  * @param {char} *name
  * @return {*}
  */
-static sEbusNode_t *EbusFindNodeByName(const char *name)
+static uint32_t EbusNameHash(const char *name)
 {
-    rt_mutex_take(g_ebus_.bus_mutex, RT_WAITING_FOREVER);
-    for (int i = 0; i < EBUS_MAX_NODE_NUM; i++)
+    uint32_t hash = 0;
+    uint32_t factor = 1;
+    for (int i = 0; i < EBUS_NAME_LEN - 1 && name[i] != '\0'; i++)
+    {
+        hash += (uint8_t)name[i] * factor;
+        factor *= 0x01000193UL;
+    }
+    return hash;
+}
+
+/**
+ * @description: 名称散列值映射到散列桶(槽位)
+ * @param {uint32_t} hash
+ * @return {*}
+ */
+static uint16_t EbusHashBucket(uint32_t hash)
+{
+    return (uint16_t)((hash ^ (hash >> 16)) % g_ebus_.slot_cap);
+}
+
+/**
+ * @description: 按名称ID查找节点，调用者需持有读锁
+ * @param {uint32_t} hash 名称ID
+ * @param {char} *name 非空时同时比对名称
+ * @return {*}
+ */
+static sEbusNode_t *EbusFindNodeByHashLocked(uint32_t hash, const char *name)
+{
+    if (g_ebus_.slot_cap == 0)
     {
-        sEbusNode_t *node = g_ebus_.node_tbl[i];
-        if (node != RT_NULL && node->init && rt_strcmp(node->name, name) == 0)
+        return RT_NULL;
+    }
+
+    uint16_t slot = g_ebus_.slot_tbl[EbusHashBucket(hash)].hash_head;
+    while (slot != EBUS_NODE_SLOT_NONE)
+    {
+        sEbusNode_t *node = g_ebus_.node_tbl[slot];
+        if (node->name_hash == hash && (name == RT_NULL || rt_strncmp(node->name, name, EBUS_NAME_LEN - 1) == 0))
         {
-            LOG_D("[Ebus] Found node by name: %s, idx: %d", name, i);
-            rt_mutex_release(g_ebus_.bus_mutex);
             return node;
         }
+        slot = node->hash_next;
     }
-    LOG_D("[Ebus] Node not found by name: %s", name);
-    rt_mutex_release(g_ebus_.bus_mutex);
     return RT_NULL;
 }
 
 /**
- * @description: 在总线中获取一个空闲的节点
+ * @description: 根据名称查找节点
+ * @param {char} *name
  * @return {*}
  */
-static int EbusFindIdleIdx(void)
+static sEbusNode_t *EbusFindNodeByName(const char *name)
 {
-    rt_mutex_take(g_ebus_.bus_mutex, RT_WAITING_FOREVER);
-    int idx = -1;
-    for (int i = 0; i < EBUS_MAX_NODE_NUM; i++)
+    EbusReadLock();
+    sEbusNode_t *node = EbusFindNodeByHashLocked(EbusNameHash(name), name);
+    EbusReadUnlock();
+    if (node != RT_NULL)
+    {
+        LOG_D("[Ebus] Found node by name: %s", name);
+    }
+    else
+    {
+        LOG_D("[Ebus] Node not found by name: %s", name);
+    }
+    return node;
+}
+
+/**
+ * @description: 将名称或名称ID解析为节点句柄
+ * @param {uint32_t} hash 名称ID
+ * @param {char} *name 为RT_NULL时仅按名称ID匹配
+ * @return {*} 未找到返回EBUS_NODE_IDX_BROADCAST
+ */
+static uint16_t EbusResolveNode(uint32_t hash, const char *name)
+{
+    uint16_t node_idx = EBUS_NODE_IDX_BROADCAST;
+
+    EbusReadLock();
+    sEbusNode_t *node = EbusFindNodeByHashLocked(hash, name);
+    if (node != RT_NULL && node->init)
+    {
+        node_idx = node->node_idx;
+    }
+    EbusReadUnlock();
+    return node_idx;
+}
+
+/**
+ * @description: 将节点挂入名称散列链，调用者需持有写锁
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+static void EbusHashInsert(sEbusNode_t *node)
+{
+    sEbusSlot_t *bucket = &g_ebus_.slot_tbl[EbusHashBucket(node->name_hash)];
+    node->hash_next = bucket->hash_head;
+    bucket->hash_head = EBUS_NODE_IDX_SLOT(node->node_idx);
+}
+
+/**
+ * @description: 将节点移出名称散列链，调用者需持有写锁
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+static void EbusHashRemove(sEbusNode_t *node)
+{
+    uint16_t target = EBUS_NODE_IDX_SLOT(node->node_idx);
+    uint16_t *link = &g_ebus_.slot_tbl[EbusHashBucket(node->name_hash)].hash_head;
+    while (*link != EBUS_NODE_SLOT_NONE)
     {
-        if (g_ebus_.node_tbl[i] == RT_NULL)
+        if (*link == target)
         {
-            idx = i;
-            LOG_D("[Ebus] Found idle slot at index: %d", idx);
-            break;
+            *link = node->hash_next;
+            node->hash_next = EBUS_NODE_SLOT_NONE;
+            return;
+        }
+        link = &g_ebus_.node_tbl[*link]->hash_next;
+    }
+}
+
+/**
+ * @description: 节点表扩容一倍，调用者需持有写锁
+ * @return {*} 成功返回RT_EOK
+ */
+static rt_err_t EbusSlotGrow(void)
+{
+    uint16_t old_cap = g_ebus_.slot_cap;
+    if (old_cap >= EBUS_NODE_MAX_SLOT_NUM)
+    {
+        return -RT_EFULL;
+    }
+
+    uint32_t new_cap = (uint32_t)old_cap * 2;
+    if (new_cap > EBUS_NODE_MAX_SLOT_NUM)
+    {
+        new_cap = EBUS_NODE_MAX_SLOT_NUM;
+    }
+
+    // 节点指针与槽位链接分配在同一块内存中，指针在前保证对齐
+    sEbusNode_t **nodes = (sEbusNode_t **)rt_malloc(new_cap * (sizeof(sEbusNode_t *) + sizeof(sEbusSlot_t)));
+    if (nodes == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+    sEbusSlot_t *tbl = (sEbusSlot_t *)(nodes + new_cap);
+    rt_memcpy(nodes, g_ebus_.node_tbl, old_cap * sizeof(sEbusNode_t *));
+    rt_memcpy(tbl, g_ebus_.slot_tbl, old_cap * sizeof(sEbusSlot_t));
+
+    // 新槽位挂入空闲链表，保持从低到高分配
+    for (uint32_t i = old_cap; i < new_cap; i++)
+    {
+        nodes[i] = RT_NULL;
+        tbl[i].free_next = EBUS_NODE_IDX_MAKE((i + 1 < new_cap) ? (i + 1) : g_ebus_.free_head, 0);
+    }
+    g_ebus_.free_head = old_cap;
+
+    if (g_ebus_.node_tbl != g_ebus_.node_static)
+    {
+        rt_free(g_ebus_.node_tbl);
+    }
+    g_ebus_.node_tbl = nodes;
+    g_ebus_.slot_tbl = tbl;
+    g_ebus_.slot_cap = (uint16_t)new_cap;
+
+    // 桶数随容量变化，重建散列链
+    for (uint32_t i = 0; i < new_cap; i++)
+    {
+        tbl[i].hash_head = EBUS_NODE_SLOT_NONE;
+    }
+    for (uint32_t i = 0; i < old_cap; i++)
+    {
+        if (nodes[i] != RT_NULL)
+        {
+            EbusHashInsert(nodes[i]);
         }
     }
-    if (idx == -1)
+
+    LOG_D("[Ebus] Node table grown: %d -> %d", old_cap, new_cap);
+    return RT_EOK;
+}
+
+/**
+ * @description: 在总线中获取一个空闲的节点槽位，调用者需持有写锁
+ * @return {*}
+ */
+static int EbusFindIdleIdx(void)
+{
+    if (g_ebus_.free_head == EBUS_NODE_SLOT_NONE && EbusSlotGrow() != RT_EOK)
     {
         LOG_W("[Ebus] No idle slots available in bus");
+        return -1;
     }
-    rt_mutex_release(g_ebus_.bus_mutex);
+
+    uint16_t idx = g_ebus_.free_head;
+    uint16_t next = EBUS_NODE_IDX_SLOT(g_ebus_.slot_tbl[idx].free_next);
+    g_ebus_.free_head = (next == EBUS_NODE_SLOT_MASK) ? EBUS_NODE_SLOT_NONE : next;
+    LOG_D("[Ebus] Found idle slot at index: %d", idx);
     return idx;
 }
 
 /**
- * @description: 通过节点id地址获取节点
- * @param {sEbusNode_t} *bus
+ * @description: 通过节点句柄获取节点，句柄代数不匹配视为节点已失效，调用者需持有读锁
+ * @param {uint16_t} node_idx
  * @return {*}
  */
-static sEbusNode_t *EbusFindNodeByIdx(uint8_t node_idx)
+static sEbusNode_t *EbusFindNodeByIdxLocked(uint16_t node_idx)
 {
-    sEbusNode_t *node = RT_NULL;
-    rt_mutex_take(g_ebus_.bus_mutex, RT_WAITING_FOREVER);
-    int idx = 0;
-    for (idx = 0; idx < EBUS_MAX_NODE_NUM; idx++)
+    uint16_t slot = EBUS_NODE_IDX_SLOT(node_idx);
+
+    if (slot < g_ebus_.slot_cap)
     {
-        if (g_ebus_.node_tbl[idx] != RT_NULL && g_ebus_.node_tbl[idx]->node_idx == node_idx)
+        sEbusNode_t *node = g_ebus_.node_tbl[slot];
+        if (node != RT_NULL && node->node_idx == node_idx)
         {
-            node = g_ebus_.node_tbl[idx];
-            LOG_D("[Ebus] Found node by idx: %d, name: %s", node_idx, node->name);
-            break;
+            LOG_D("[Ebus] Found node by idx: 0x%04X, name: %s", node_idx, node->name);
+            return node;
         }
     }
-    if (node == RT_NULL)
-    {
-        LOG_D("[Ebus] Node not found by idx: %d", node_idx);
-    }
-    rt_mutex_release(g_ebus_.bus_mutex);
+    LOG_D("[Ebus] Node not found by idx: 0x%04X", node_idx);
+    return RT_NULL;
+}
+
+/**
+ * @description: 通过节点句柄获取节点
+ * @param {uint16_t} node_idx
+ * @return {*}
+ */
+static sEbusNode_t *EbusFindNodeByIdx(uint16_t node_idx)
+{
+    EbusReadLock();
+    sEbusNode_t *node = EbusFindNodeByIdxLocked(node_idx);
+    EbusReadUnlock();
     return node;
 }
 
 /**
- * @description: 在节点中查找等待响应的项
+ * @description: 在节点中按(响应方,序列号)查找等待响应的项，汇聚指示的等待项由EbusGatherCollect核对响应方
  * @param {sEbusNode_t} *node
- * @param {uint16_t} seq_num
- * @param {uint8_t} src_node_idx
+ * @param {uint32_t} seq_num
+ * @param {uint16_t} src_node_idx 响应方句柄
  * @return {*} 找到返回索引，未找到返回 -1
  */
-static int EbusFindWaitRespItem(sEbusNode_t *node, uint16_t seq_num)
+static int EbusFindWaitRespItem(sEbusNode_t *node, uint32_t seq_num, uint16_t src_node_idx)
 {
     if (node == RT_NULL || !node->init)
     {
@@ -109,10 +438,11 @@ static int EbusFindWaitRespItem(sEbusNode_t *node, uint16_t seq_num)
     }
 
     rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
-    for (int i = 0; i < EBUS_NODE_MAX_RESP_WAIT_NUM; i++)
+    for (int i = 0; i < node->wait_resp_num; i++)
     {
-        if (node->wait_resp_list[i].state != eEbusMsgState_Idle &&
-            node->wait_resp_list[i].seq_num == seq_num)
+        sEbusWaitResp_t *item = &node->wait_resp_list[i];
+        if (item->state != eEbusMsgState_Idle && item->seq_num == seq_num &&
+            (item->gather != 0 || item->dst_node_idx == src_node_idx))
         {
             LOG_D("[Ebus] Found wait response item: seq=%d, idx=%d, node=%s",
                   seq_num, i, node->name);
@@ -126,7 +456,7 @@ static int EbusFindWaitRespItem(sEbusNode_t *node, uint16_t seq_num)
 }
 
 /**
- * @description: 在节点中分配一个等待响应的项
+ * @description: 在节点中分配一个等待响应的项，分配即占用
  * @param {sEbusNode_t} *node
  * @return {*} 成功返回索引，失败返回 -1
  */
@@ -139,21 +469,125 @@ static int EbusAllocWaitRespItem(sEbusNode_t *node)
     }
 
     rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
-    for (int i = 0; i < EBUS_NODE_MAX_RESP_WAIT_NUM; i++)
+    for (int i = 0; i < node->wait_resp_num; i++)
     {
         if (node->wait_resp_list[i].state == eEbusMsgState_Idle)
         {
+            node->wait_resp_list[i].state = eEbusMsgState_Sented;
+            node->wait_resp_used++;
+            if (node->wait_resp_used > node->stat.resp_wait_hwm)
+            {
+                node->stat.resp_wait_hwm = node->wait_resp_used;
+            }
             LOG_D("[Ebus] Allocated wait response item: idx=%d, node=%s", i, node->name);
             rt_mutex_release(node->resp_mutex);
             return i;
         }
     }
+    node->stat.resp_full_cnt++;
     LOG_W("[Ebus] No available wait response slots for node: %s", node->name);
     rt_mutex_release(node->resp_mutex);
 
     return -1;
 }
 
+/**
+ * @description: 清空等待响应项，调用者需持有resp_mutex
+ * @param {sEbusNode_t} *node
+ * @param {sEbusWaitResp_t} *item
+ * @return {*}
+ */
+static void EbusClearWaitRespItemLocked(sEbusNode_t *node, sEbusWaitResp_t *item)
+{
+    if (item->state != eEbusMsgState_Idle)
+    {
+        node->wait_resp_used--;
+        if (item->timeout != 0)
+        {
+            node->wait_resp_timed--;
+        }
+    }
+    if (item->retry != 0)
+    {
+        rt_base_t level = rt_spin_lock_irqsave(&g_ebus_.retry_lock);
+        g_ebus_.retry[item->retry - 1].used = 0;
+        rt_spin_unlock_irqrestore(&g_ebus_.retry_lock, level);
+    }
+    rt_memset(item, 0, sizeof(sEbusWaitResp_t));
+    item->state = eEbusMsgState_Idle;
+}
+
+/**
+ * @description: 查找应答对应的发送者上下文
+ * @param {sEbusNode_t} *node
+ * @param {uint32_t} seq_num
+ * @param {uint16_t} src_node_idx 响应方句柄
+ * @return {*} 等待项已超时释放或未设置上下文时返回RT_NULL
+ */
+static void *EbusFindWaitRespCtx(sEbusNode_t *node, uint32_t seq_num, uint16_t src_node_idx)
+{
+    void *ctx = RT_NULL;
+    int idx = EbusFindWaitRespItem(node, seq_num, src_node_idx);
+    if (idx >= 0)
+    {
+        rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
+        ctx = node->wait_resp_list[idx].ctx;
+        rt_mutex_release(node->resp_mutex);
+    }
+    return ctx;
+}
+
+/**
+ * @description: 发送指示前从目标节点取一个信用
+ * @param {uint16_t} dst_node_idx
+ * @param {uint8_t} *credit 输出是否实际占用了信用，目标未启用信用流控时为0
+ * @return {*} 目标没有剩余信用返回RT_FALSE
+ */
+static rt_bool_t EbusCreditTake(uint16_t dst_node_idx, uint8_t *credit)
+{
+    rt_bool_t ok = RT_TRUE;
+
+    *credit = 0;
+    EbusReadLock();
+    sEbusNode_t *target_node = EbusFindNodeByIdxLocked(dst_node_idx);
+    if (target_node != RT_NULL && target_node->credit_max != 0)
+    {
+        rt_atomic_t avail = rt_atomic_load(&target_node->credit);
+        do
+        {
+            if (avail <= 0)
+            {
+                ok = RT_FALSE;
+                break;
+            }
+        } while (!rt_atomic_compare_exchange_strong(&target_node->credit, &avail, avail - 1));
+        *credit = ok ? 1 : 0;
+    }
+    EbusReadUnlock();
+    return ok;
+}
+
+/**
+ * @description: 归还目标节点的信用，目标已销毁时忽略
+ * @param {uint16_t} dst_node_idx EBUS_NODE_IDX_BROADCAST表示无需归还
+ * @return {*}
+ */
+static void EbusCreditGive(uint16_t dst_node_idx)
+{
+    if (dst_node_idx == EBUS_NODE_IDX_BROADCAST)
+    {
+        return;
+    }
+
+    EbusReadLock();
+    sEbusNode_t *target_node = EbusFindNodeByIdxLocked(dst_node_idx);
+    if (target_node != RT_NULL && target_node->credit_max != 0)
+    {
+        rt_atomic_add(&target_node->credit, 1);
+    }
+    EbusReadUnlock();
+}
+
 /**
  * @description: 释放等待响应的项
  * @param {sEbusNode_t} *node
@@ -162,7 +596,7 @@ static int EbusAllocWaitRespItem(sEbusNode_t *node)
  */
 static void EbusFreeWaitRespItem(sEbusNode_t *node, int idx)
 {
-    if (node == RT_NULL || !node->init || idx < 0 || idx >= EBUS_NODE_MAX_RESP_WAIT_NUM)
+    if (node == RT_NULL || !node->init || idx < 0 || idx >= node->wait_resp_num)
     {
         LOG_E("[Ebus] Invalid parameters when freeing wait response item");
         return;
@@ -170,12 +604,37 @@ static void EbusFreeWaitRespItem(sEbusNode_t *node, int idx)
 
     rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
     LOG_D("[Ebus] Freeing wait response item: node=%s, idx=%d", node->name, idx);
-    node->wait_resp_list[idx].seq_num = 0;
-    node->wait_resp_list[idx].src_node_idx = 0;
-    node->wait_resp_list[idx].dst_node_idx = 0;
-    node->wait_resp_list[idx].send_time = 0;
-    node->wait_resp_list[idx].state = eEbusMsgState_Idle;
+    sEbusWaitResp_t *item = &node->wait_resp_list[idx];
+    uint16_t credit_idx = item->credit ? item->dst_node_idx : EBUS_NODE_IDX_BROADCAST;
+    EbusClearWaitRespItemLocked(node, item);
     rt_mutex_release(node->resp_mutex);
+
+    // 归还信用需要读锁，不在resp_mutex内获取
+    EbusCreditGive(credit_idx);
+}
+
+/**
+ * @description: 以eEBusEvtType_IndicationTimeoutCb通知请求方指示未得到响应，调用者不能持有锁
+ * @param {sEbusNode_t} *node 请求方
+ * @param {sEbusWaitResp_t} *item 已释放的等待项副本
+ * @return {*}
+ */
+static void EbusWaitRespTimeoutCb(sEbusNode_t *node, const sEbusWaitResp_t *item)
+{
+    sEbusMsgItem_t msg;
+    rt_memset(&msg, 0, sizeof(msg));
+    msg.type = eEbusMsgType_Response;
+    msg.src_node_idx = item->dst_node_idx;
+    msg.dst_node_idx = item->src_node_idx;
+    msg.seq_num = item->seq_num;
+    msg.timestamp = rt_tick_get();
+
+    LOG_D("[Ebus] Response timeout: node=%s, seq=%d, dst=0x%04X",
+          node->name, msg.seq_num, msg.src_node_idx);
+    if (node->Evtcb != RT_NULL)
+    {
+        node->Evtcb(eEBusEvtType_IndicationTimeoutCb, node, &msg, item->ctx);
+    }
 }
 
 /**
@@ -192,7 +651,7 @@ static void EbusProcessResponse(sEbusNode_t *node, sEbusMsgItem_t *msg)
         return;
     }
 
-    int idx = EbusFindWaitRespItem(node, msg->seq_num);
+    int idx = EbusFindWaitRespItem(node, msg->seq_num, msg->src_node_idx);
     if (idx >= 0)
     {
         LOG_D("[Ebus] Processing response: seq=%d, node=%s, src=%d, dst=%d",
@@ -206,516 +665,3649 @@ static void EbusProcessResponse(sEbusNode_t *node, sEbusMsgItem_t *msg)
 }
 
 /**
- * @description: 将总线内的节点初始化
- * @param {uint8_t} idx
- * @param {sEbusNode_t} *bus
- * @return {*}
+ * @description: 查找应答所属的汇聚指示
+ * @param {sEbusNode_t} *node
+ * @param {uint32_t} seq_num
+ * @param {uint16_t} src_node_idx 响应方句柄
+ * @return {*} 汇聚指示序号，普通指示或等待项已释放返回-1
  */
-static void EbusBusInit(uint8_t idx, sEbusNode_t *node)
+static int EbusFindWaitRespGather(sEbusNode_t *node, uint32_t seq_num, uint16_t src_node_idx)
 {
-    if (idx >= EBUS_MAX_NODE_NUM || node == RT_NULL)
+    int gather_no = -1;
+    int idx = EbusFindWaitRespItem(node, seq_num, src_node_idx);
+    if (idx >= 0)
     {
-        LOG_E("[Ebus] Invalid bus init parameters: idx=%d", idx);
-        return;
+        rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
+        gather_no = (int)node->wait_resp_list[idx].gather - 1;
+        rt_mutex_release(node->resp_mutex);
     }
-
-    rt_mutex_take(g_ebus_.bus_mutex, RT_WAITING_FOREVER);
-    g_ebus_.node_tbl[idx] = node;
-    node->node_idx = idx;
-    node->init = 1;
-    LOG_D("[Ebus] Bus node registered: name=%s, idx=%d", node->name, idx);
-    rt_mutex_release(g_ebus_.bus_mutex);
+    return gather_no;
 }
 
 /**
- * @description: 将总线内的节点去初始化
- * @param {uint8_t} idx
+ * @description: 归还汇聚指示仍占用的信用并释放表项
+ * @param {sEbusGather_t} *gather
  * @return {*}
  */
-static void EbusBusDeinit(uint8_t idx)
+static void EbusGatherRelease(sEbusGather_t *gather)
 {
-    if (idx >= EBUS_MAX_NODE_NUM)
+    for (int i = 0; i < gather->dst_num; i++)
     {
-        LOG_E("[Ebus] Invalid bus deinit index: %d", idx);
-        return;
+        if (gather->credit_mask & (1UL << i))
+        {
+            EbusCreditGive(gather->dst_node_idx[i]);
+        }
     }
+    gather->credit_mask = 0;
 
-    rt_mutex_take(g_ebus_.bus_mutex, RT_WAITING_FOREVER);
-    if (g_ebus_.node_tbl[idx] != RT_NULL)
-    {
-        LOG_D("[Ebus] Bus node unregistered: idx=%d", idx);
-        g_ebus_.node_tbl[idx] = RT_NULL;
-    }
-    rt_mutex_release(g_ebus_.bus_mutex);
+    rt_base_t level = rt_spin_lock_irqsave(&g_ebus_.gather_lock);
+    gather->used = 0;
+    rt_spin_unlock_irqrestore(&g_ebus_.gather_lock, level);
 }
 
 /**
- * @description: 消息发送
- * @param {sEbusNode_t} *node
- * @param {sEbusMsgItem_t} *msg
+ * @description: 汇聚指示完成，交付全部已收到的响应后释放
+ * @param {sEbusNode_t} *node 请求方
+ * @param {sEbusGather_t} *gather
+ * @param {eEbusRst_t} rst eEbusRst_Success全部响应，eEbusRst_Timeout部分响应
  * @return {*}
  */
-static eEbusRst_t EbusMsgSend(sEbusNode_t *node, sEbusMsgItem_t *msg_item)
+static void EbusGatherFinish(sEbusNode_t *node, sEbusGather_t *gather, eEbusRst_t rst)
 {
-    if (node == RT_NULL || !node->init || msg_item == RT_NULL)
+    LOG_D("[Ebus] Gather finished: node=%s, seq=%d, recv=0x%08X/0x%08X",
+          node->name, gather->seq_num, gather->recv_mask, gather->sent_mask);
+    if (gather->on_complete != RT_NULL)
     {
-        LOG_E("[Ebus] Message send parameter error: node=%p, msg=%p", node, msg_item);
-        return eEbusRst_ParamErr;
+        gather->on_complete(node, rst, gather, gather->ctx);
     }
+    EbusGatherRelease(gather);
+}
 
-    LOG_D("[Ebus] Sending message: type=%d, src=%d, dst=%d, seq=%d",
-          msg_item->type, msg_item->src_node_idx, msg_item->dst_node_idx, msg_item->seq_num);
+/**
+ * @description: 记录汇聚指示的一个响应，全部到达时完成
+ * @param {sEbusNode_t} *node 请求方
+ * @param {int} gather_no
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+static void EbusGatherCollect(sEbusNode_t *node, int gather_no, sEbusMsgItem_t *msg)
+{
+    sEbusGather_t *gather = &g_ebus_.gather[gather_no];
+    int i;
 
-    switch (msg_item->type)
+    for (i = 0; i < gather->dst_num; i++)
     {
-    case eEbusMsgType_Broadcast:
+        if (gather->dst_node_idx[i] == msg->src_node_idx && (gather->sent_mask & (1UL << i)))
+        {
+            break;
+        }
+    }
+    if (i == gather->dst_num || (gather->recv_mask & (1UL << i)))
     {
-            /* 广播消息：发送给所有已注册的节点（除了自己） */
-        int send_count = 0;
-        rt_mutex_take(g_ebus_.bus_mutex, RT_WAITING_FOREVER);
-        for (int i = 0; i < EBUS_MAX_NODE_NUM; i++)
+        LOG_W("[Ebus] Unexpected gather response: seq=%d, src=0x%04X", msg->seq_num, msg->src_node_idx);
+        return;
+    }
+
+    gather->resp[i] = *msg;
+    gather->recv_mask |= 1UL << i;
+    if (gather->credit_mask & (1UL << i))
+    {
+        gather->credit_mask &= ~(1UL << i);
+        EbusCreditGive(msg->src_node_idx);
+    }
+
+    if (gather->recv_mask == gather->sent_mask)
+    {
+        EbusFreeWaitRespItem(node, EbusFindWaitRespItem(node, msg->seq_num, msg->src_node_idx));
+        EbusGatherFinish(node, gather, eEbusRst_Success);
+    }
+}
+
+/**
+ * @description: 将节点注册到总线，分配槽位与句柄
+ * @param {sEbusNode_t} *node
+ * @return {*} 成功返回RT_EOK
+ */
+static rt_err_t EbusBusInit(sEbusNode_t *node)
+{
+    if (node == RT_NULL)
+    {
+        LOG_E("[Ebus] Invalid bus init parameters");
+        return -RT_EINVAL;
+    }
+    if (!g_ebus_.init)
+    {
+        LOG_E("[Ebus] Bus not initialized, node: %s", node->name);
+        return -RT_ERROR;
+    }
+
+    uint32_t hash = EbusNameHash(node->name);
+
+    EbusWriteLock();
+    // 名称ID须唯一，重名或散列冲突都拒绝注册
+    sEbusNode_t *exist = EbusFindNodeByHashLocked(hash, RT_NULL);
+    if (exist != RT_NULL)
+    {
+        LOG_E("[Ebus] Node name collision: %s vs %s, id=0x%08X", node->name, exist->name, hash);
+        EbusWriteUnlock();
+        return -RT_EBUSY;
+    }
+
+    int idx = EbusFindIdleIdx();
+    if (idx < 0)
+    {
+        EbusWriteUnlock();
+        return -RT_EFULL;
+    }
+
+    g_ebus_.node_tbl[idx] = node;
+    node->node_idx = EBUS_NODE_IDX_MAKE(idx, EBUS_NODE_IDX_GEN(g_ebus_.slot_tbl[idx].free_next) + 1);
+    node->name_hash = hash;
+    EbusHashInsert(node);
+    node->init = 1;
+    g_ebus_.node_len++;
+    LOG_D("[Ebus] Bus node registered: name=%s, idx=0x%04X", node->name, node->node_idx);
+    EbusWriteUnlock();
+    return RT_EOK;
+}
+
+/**
+ * @description: 按组名称ID查找组播组，调用者需持有注册表锁
+ * @param {uint32_t} group_id
+ * @return {*} 组序号，未找到返回-1
+ */
+static int EbusGroupFindLocked(uint32_t group_id)
+{
+    for (int i = 0; i < EBUS_GROUP_NUM; i++)
+    {
+        if (g_ebus_.group[i].used && g_ebus_.group[i].group_id == group_id)
         {
-            sEbusNode_t *target_node = g_ebus_.node_tbl[i];
-            if (target_node != RT_NULL && target_node->init && target_node != node)
-            {
-                rt_err_t result = rt_mq_send(target_node->msg_queue, msg_item, sizeof(sEbusMsgItem_t));
-                if (result == RT_EOK)
-                {
-                    send_count++;
-                    LOG_D("[Ebus] Broadcast sent to node: %s", target_node->name);
-                }
-                else if (result == -RT_EFULL)
-                {
-                    LOG_W("[Ebus] Node %s message queue full, drop broadcast", target_node->name);
-                }
-                else
-                {
-                    LOG_E("[Ebus] Send broadcast to node %s failed: %d", target_node->name, result);
-                }
-            }
+            return i;
         }
-        rt_mutex_release(g_ebus_.bus_mutex);
-        LOG_D("[Ebus] Broadcast completed: src=%d, seq=%d, sent_to=%d nodes",
-              msg_item->src_node_idx, msg_item->seq_num, send_count);
     }
-    break;
+    return -1;
+}
 
-    case eEbusMsgType_Response:
-    case eEbusMsgType_Notification:
-    case eEbusMsgType_Indication:
+/**
+ * @description: 节点退出所有组播组，调用者需持有写锁
+ * @param {uint16_t} node_idx
+ * @return {*}
+ */
+static void EbusGroupRemoveLocked(uint16_t node_idx)
+{
+    for (int i = 0; i < EBUS_GROUP_NUM; i++)
     {
-        sEbusNode_t *target_node = (sEbusNode_t *)EbusFindNodeByIdx(msg_item->dst_node_idx);
-        if (target_node != RT_NULL)
+        sEbusGroup_t *group = &g_ebus_.group[i];
+        for (int m = 0; group->used && m < group->member_num; m++)
         {
-            rt_err_t result = rt_mq_send(target_node->msg_queue, msg_item, sizeof(sEbusMsgItem_t));
-            if (result == RT_EOK)
-            {
-                LOG_D("[Ebus] Message sent: type=%d, src=%d->%s, dst=%d->%s, seq=%x, evt=%x, len=%d",
-                      msg_item->type,
-                      msg_item->src_node_idx, node->name,
-                      msg_item->dst_node_idx, target_node->name,
-                      msg_item->seq_num, msg_item->evt_id, msg_item->len);
-            }
-            else if (result == -RT_EFULL)
-            {
-                LOG_E("[Ebus] Target node %s message queue full, drop message", target_node->name);
-                return eEbusRst_QueueFull;
-            }
-            else
+            if (group->member[m] == node_idx)
             {
-                LOG_E("[Ebus] Send to node %s failed: %d", target_node->name, result);
-                return eEbusRst_Fail;
+                // 末尾成员补位，成员顺序不保证
+                group->member[m] = group->member[--group->member_num];
+                break;
             }
         }
-        else
+    }
+}
+
+/**
+ * @description: 将总线内的节点去初始化，槽位归还空闲链表
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+static void EbusBusDeinit(sEbusNode_t *node)
+{
+    uint16_t idx = EBUS_NODE_IDX_SLOT(node->node_idx);
+
+    EbusWriteLock();
+    if (idx < g_ebus_.slot_cap && g_ebus_.node_tbl[idx] == node)
+    {
+        LOG_D("[Ebus] Bus node unregistered: idx=0x%04X", node->node_idx);
+        EbusHashRemove(node);
+        EbusGroupRemoveLocked(node->node_idx);
+        // 空闲槽位的链接同时保存代数，复用时在此基础上递增
+        g_ebus_.node_tbl[idx] = RT_NULL;
+        g_ebus_.slot_tbl[idx].free_next = EBUS_NODE_IDX_MAKE(g_ebus_.free_head, EBUS_NODE_IDX_GEN(node->node_idx));
+        g_ebus_.free_head = idx;
+        g_ebus_.node_len--;
+    }
+    else
+    {
+        LOG_E("[Ebus] Invalid bus deinit index: 0x%04X", node->node_idx);
+    }
+    EbusWriteUnlock();
+}
+
+/**
+ * @description: 节点加入工作线程就绪队列，带截止时间的节点按最早截止时间优先排在队头，
+ *               其余节点排在队尾，调用者需持有该工作线程的锁
+ * @param {sEbusExecWorker_t} *worker
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+static void EbusExecLinkLocked(sEbusExecWorker_t *worker, sEbusNode_t *node)
+{
+    sEbusNode_t *next = RT_NULL;
+
+    if (node->exec_urgent)
+    {
+        next = worker->head;
+        while (next != RT_NULL && next->exec_linked == EBUS_EXEC_LINK_URGENT &&
+               !EBUS_DEADLINE_BEFORE(node->exec_deadline, next->exec_deadline))
         {
-            LOG_E("[Ebus] Target node not found: idx=%d", msg_item->dst_node_idx);
-            return eEbusRst_NodeNotFound;
+            next = next->exec_next;
         }
+        node->exec_linked = EBUS_EXEC_LINK_URGENT;
+        rt_atomic_add(&g_ebus_exec_.urgent_num, 1);
+    }
+    else
+    {
+        node->exec_linked = EBUS_EXEC_LINK_NORMAL;
     }
-    break;
 
-    default:
-        LOG_E("[Ebus] Unknown message type: %d", msg_item->type);
-        return eEbusRst_ParamErr;
+    // 插入到next之前，next为空时插入队尾
+    node->exec_next = next;
+    node->exec_prev = (next != RT_NULL) ? next->exec_prev : worker->tail;
+    if (node->exec_prev != RT_NULL)
+    {
+        node->exec_prev->exec_next = node;
     }
-    return eEbusRst_Success;
+    else
+    {
+        worker->head = node;
+    }
+    if (next != RT_NULL)
+    {
+        next->exec_prev = node;
+    }
+    else
+    {
+        worker->tail = node;
+    }
+    node->exec_worker = worker->id;
 }
 
 /**
- * @description: 总线创建
+ * @description: 节点移出工作线程就绪队列，调用者需持有该工作线程的锁
+ * @param {sEbusExecWorker_t} *worker
+ * @param {sEbusNode_t} *node
  * @return {*}
  */
-void EbusCreate(void)
+static void EbusExecUnlinkLocked(sEbusExecWorker_t *worker, sEbusNode_t *node)
 {
-    if (g_ebus_.init)
+    if (node->exec_prev != RT_NULL)
     {
-        LOG_W("[Ebus] Bus already initialized");
-        return;
+        node->exec_prev->exec_next = node->exec_next;
     }
+    else
+    {
+        worker->head = node->exec_next;
+    }
+    if (node->exec_next != RT_NULL)
+    {
+        node->exec_next->exec_prev = node->exec_prev;
+    }
+    else
+    {
+        worker->tail = node->exec_prev;
+    }
+    node->exec_prev = RT_NULL;
+    node->exec_next = RT_NULL;
+    if (node->exec_linked == EBUS_EXEC_LINK_URGENT)
+    {
+        rt_atomic_sub(&g_ebus_exec_.urgent_num, 1);
+    }
+    node->exec_linked = EBUS_EXEC_LINK_NONE;
+}
 
-    LOG_D("[Ebus] Creating ebus...");
-    rt_memset(&g_ebus_, 0x00, sizeof(g_ebus_));
-    g_ebus_.init = 1;
-    g_ebus_.node_len = 0;
-    g_ebus_.bus_mutex = rt_mutex_create("ebusmtx", RT_IPC_FLAG_FIFO);
-    if (g_ebus_.bus_mutex == RT_NULL)
+/**
+ * @description: 工作线程能否执行节点：节点未指定所属核、所属核上没有工作线程，或工作线程绑定在所属核上
+ * @param {sEbusExecWorker_t} *worker
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+static rt_bool_t EbusExecMayRun(sEbusExecWorker_t *worker, sEbusNode_t *node)
+{
+    return node->home_cpu == EBUS_CPU_ANY || node->home_cpu >= g_ebus_exec_.worker_num ||
+           node->home_cpu == worker->cpu;
+}
+
+/**
+ * @description: 为节点分配工作线程，指定所属核的节点在该核的工作线程之间轮流分配
+ * @param {sEbusNode_t} *node
+ * @return {*} 工作线程编号
+ */
+static uint8_t EbusExecPickWorker(sEbusNode_t *node)
+{
+    rt_atomic_t seq = rt_atomic_add(&g_ebus_exec_.next_worker, 1);
+
+    if (node->home_cpu == EBUS_CPU_ANY || node->home_cpu >= g_ebus_exec_.worker_num)
+    {
+        return (uint8_t)(seq % g_ebus_exec_.worker_num);
+    }
+    // 工作线程i绑定在i % EBUS_CPU_NUM核上
+    uint8_t cnt = (uint8_t)((g_ebus_exec_.worker_num - 1 - node->home_cpu) / EBUS_CPU_NUM + 1);
+    return (uint8_t)(node->home_cpu + (seq % cnt) * EBUS_CPU_NUM);
+}
+
+/**
+ * @description: 唤醒节点所在的工作线程，该线程忙时再唤醒一个能执行该节点的空闲工作线程来窃取，可在中断中调用
+ * @param {sEbusExecWorker_t} *worker 节点所在的工作线程
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+static void EbusExecWake(sEbusExecWorker_t *worker, sEbusNode_t *node)
+{
+    rt_atomic_t idle = rt_atomic_load(&g_ebus_exec_.idle_mask);
+
+    rt_sem_release(&worker->sem);
+    if (idle == 0 || (idle & ((rt_atomic_t)1 << worker->id)))
     {
-        LOG_E("[Ebus] Failed to create bus mutex");
         return;
     }
-    LOG_D("[Ebus] Ebus created successfully");
+    for (int i = 1; i < g_ebus_exec_.worker_num; i++)
+    {
+        sEbusExecWorker_t *other = &g_ebus_exec_.worker[(worker->id + i) % g_ebus_exec_.worker_num];
+        rt_atomic_t bit = (rt_atomic_t)1 << other->id;
+        // 清除空闲位即认领该线程，并发的调度不会重复唤醒同一个线程
+        if ((idle & bit) && EbusExecMayRun(other, node) && (rt_atomic_and(&g_ebus_exec_.idle_mask, ~bit) & bit))
+        {
+            rt_sem_release(&other->sem);
+            break;
+        }
+    }
 }
 
 /**
- * @description: 总线销毁
+ * @description: 节点回到空闲或工作线程离开节点后，唤醒等待的EbusExecDetach，可在中断中调用
  * @return {*}
  */
-void EbusDestory(void)
+static void EbusExecDetachWake(void)
 {
-    if (!g_ebus_.init)
+    if (rt_atomic_load(&g_ebus_exec_.detach_wait) != 0)
+    {
+        EbusWakeWaiters(&g_ebus_exec_.detach_wait, &g_ebus_exec_.detach_sem);
+    }
+}
+
+/**
+ * @description: 节点有新消息时放入工作线程就绪队列，已就绪或执行中的节点不重复放入，可在中断中调用
+ * @param {sEbusNode_t} *node
+ * @param {rt_bool_t} earlier 节点的最早截止时刻提前了，已就绪时需要调整位置
+ * @return {*}
+ */
+static void EbusExecSchedule(sEbusNode_t *node, rt_bool_t earlier)
+{
+    if (!node->exec_attached || !rt_atomic_load(&g_ebus_exec_.running))
     {
-        LOG_W("[Ebus] Bus not initialized, skip destroy");
         return;
     }
 
-    LOG_D("[Ebus] Destroying ebus...");
+    sEbusExecWorker_t *worker;
+    rt_base_t level;
+    rt_atomic_t state = EBUS_EXEC_STATE_IDLE;
+    if (!rt_atomic_compare_exchange_strong(&node->exec_state, &state, EBUS_EXEC_STATE_READY))
+    {
+        // 执行中的节点由工作线程结束后重新检查队列
+        if (earlier && state == EBUS_EXEC_STATE_READY)
+        {
+            worker = &g_ebus_exec_.worker[node->exec_worker % g_ebus_exec_.worker_num];
+            level = rt_spin_lock_irqsave(&worker->lock);
+            if (node->exec_linked != EBUS_EXEC_LINK_NONE && node->exec_worker == worker->id)
+            {
+                EbusExecUnlinkLocked(worker, node);
+                EbusExecLinkLocked(worker, node);
+            }
+            rt_spin_unlock_irqrestore(&worker->lock, level);
+        }
+        return;
+    }
 
-    if (g_ebus_.bus_mutex)
+    // 优先放回上次执行的工作线程，所属核改变后重新分配
+    worker = &g_ebus_exec_.worker[node->exec_worker % g_ebus_exec_.worker_num];
+    if (!EbusExecMayRun(worker, node))
     {
-        rt_mutex_delete(g_ebus_.bus_mutex);
-        g_ebus_.bus_mutex = RT_NULL;
-        LOG_D("[Ebus] Bus mutex deleted");
+        worker = &g_ebus_exec_.worker[EbusExecPickWorker(node)];
     }
+    level = rt_spin_lock_irqsave(&worker->lock);
+    if (!node->exec_attached)
+    {
+        // 检查挂接后节点已退出执行器，不再入队，唤醒等待其回到空闲的EbusExecDetach
+        rt_atomic_store(&node->exec_state, EBUS_EXEC_STATE_IDLE);
+        rt_spin_unlock_irqrestore(&worker->lock, level);
+        EbusExecDetachWake();
+        return;
+    }
+    EbusExecLinkLocked(worker, node);
+    rt_spin_unlock_irqrestore(&worker->lock, level);
 
-    g_ebus_.init = 0;
-    rt_memset(&g_ebus_, 0x00, sizeof(g_ebus_));
-    LOG_D("[Ebus] Ebus destroyed successfully");
+    EbusExecWake(worker, node);
 }
 
 /**
- * @description: 总线内节点创建
- * @param {char} *name
- * @param {AsyncIndicationCb} ackcb
- * @param {void} *user_data
- * @return {*}
+ * @description: 检查消息是否通过目标节点的内容过滤，调用者需持有读锁，可在中断中调用
+ * @param {sEbusNode_t} *target_node
+ * @param {sEbusMsgItem_t} *msg_item
+ * @return {*} 指示和响应总是通过
  */
-sEbusNode_t *EbusNodeCreate(char *name, EbusCbPtr EvtCb)
+static rt_bool_t EbusFilterPass(const sEbusNode_t *target_node, const sEbusMsgItem_t *msg_item)
 {
-    if (name == RT_NULL || EvtCb == RT_NULL)
+    if (msg_item->type == eEbusMsgType_Indication || msg_item->type == eEbusMsgType_Response)
     {
-        LOG_E("[Ebus] Invalid parameters for node creation");
-        return RT_NULL;
+        return RT_TRUE;
     }
 
-    LOG_D("[Ebus] Creating node: %s", name);
+    for (int i = 0; i < target_node->filter_num; i++)
+    {
+        const sEbusFilter_t *filter = &target_node->filter[i];
+        if (filter->evt_id != msg_item->evt_id)
+        {
+            continue;
+        }
+        // 数据长度不足以比较时视为不匹配
+        if (filter->offset + filter->len > msg_item->len)
+        {
+            return RT_FALSE;
+        }
+        uint32_t val = 0;
+        for (int b = 0; b < filter->len; b++)
+        {
+            val |= (uint32_t)msg_item->data[filter->offset + b] << (8 * b);
+        }
+        if ((val & filter->mask) != filter->value)
+        {
+            return RT_FALSE;
+        }
+    }
 
-    sEbusNode_t *node = (sEbusNode_t *)rt_malloc(sizeof(sEbusNode_t));
-    if (node == RT_NULL)
+    if (target_node->filter_fn != RT_NULL)
     {
-        LOG_E("[Ebus] Failed to allocate memory for node: %s", name);
-        return RT_NULL;
+        return target_node->filter_fn(target_node, msg_item, target_node->filter_arg);
     }
-    rt_memset(node, 0, sizeof(sEbusNode_t));
+    return RT_TRUE;
+}
 
-    rt_strncpy(node->name, name, EBUS_NAME_LEN - 1);
-    node->name[EBUS_NAME_LEN - 1] = '\0';
-    node->Evtcb = EvtCb;
+/**
+ * @description: 投递消息到目标节点队列，按实际长度拷贝并更新目标节点统计
+ * @param {sEbusNode_t} *target_node
+ * @param {sEbusMsgItem_t} *msg_item
+ * @return {*}
+ */
+static rt_err_t EbusMsgPut(sEbusNode_t *target_node, const sEbusMsgItem_t *msg_item)
+{
+    sEbusNodeStat_t *stat = &target_node->stat;
 
-    // 初始化等待响应列表
-    for (int i = 0; i < EBUS_NODE_MAX_RESP_WAIT_NUM; i++)
+    if (msg_item->len > target_node->msg_size)
     {
-        node->wait_resp_list[i].state = eEbusMsgState_Idle;
+        LOG_E("[Ebus] Message too long for node %s: len=%d, max=%d",
+              target_node->name, msg_item->len, target_node->msg_size);
+        return -RT_EINVAL;
     }
 
-    // 创建响应互斥量
-    node->resp_mutex = rt_mutex_create("respmtx", RT_IPC_FLAG_FIFO);
-    if (node->resp_mutex == RT_NULL)
+    // 未通过过滤的消息不占用队列，也不唤醒接收方，对发送方视为投递成功
+    if ((target_node->filter_num != 0 || target_node->filter_fn != RT_NULL) &&
+        !EbusFilterPass(target_node, msg_item))
     {
-        LOG_E("[Ebus] Failed to create response mutex for node: %s", name);
-        rt_free(node);
-        return RT_NULL;
+        stat->filtered_cnt++;
+        return RT_EOK;
     }
 
-    // 创建消息队列
-    char mq_name[EBUS_NAME_LEN] = { 0 };
-    rt_snprintf(mq_name, EBUS_NAME_LEN, "%s_mq", name);
-    node->msg_queue = rt_mq_create(mq_name, sizeof(sEbusMsgItem_t), EBUS_MAX_MSG_NUM, RT_IPC_FLAG_FIFO);
-    if (node->msg_queue == RT_NULL)
+    if (target_node->port != RT_NULL)
     {
-        LOG_E("[Ebus] Failed to create message queue for node: %s", name);
-        rt_mutex_delete(node->resp_mutex);
-        rt_free(node);
-        return RT_NULL;
+        // 端口节点代表总线外的节点，端口注入的消息不再转发出去，避免在两条总线间循环
+        if (msg_item->flag & EBUS_MSG_FLAG_REMOTE)
+        {
+            return RT_EOK;
+        }
+        sEbusNode_t *src_node = EbusFindNodeByIdxLocked(msg_item->src_node_idx);
+        rt_err_t result = target_node->port(target_node, (src_node != RT_NULL) ? src_node->name_hash : 0,
+                                            msg_item, target_node->port_arg);
+        if (result == -RT_EFULL)
+        {
+            stat->queue_full_cnt++;
+        }
+        return result;
+    }
+
+    rt_err_t result = rt_mq_send(target_node->msg_queue, msg_item, EBUS_MSG_ITEM_SIZE(msg_item->len));
+    if (result == RT_EOK)
+    {
+        // 统计值无锁更新，仅作容量评估参考
+        uint16_t entry = target_node->msg_queue->entry;
+        if (entry > stat->msg_hwm)
+        {
+            stat->msg_hwm = entry;
+        }
+        if (msg_item->len > stat->msg_len_hwm)
+        {
+            stat->msg_len_hwm = msg_item->len;
+        }
+        if (target_node->exec_attached)
+        {
+            // 记录队列中最早的截止时刻，执行器据此在节点间排序，无锁更新只影响调度先后
+            rt_bool_t earlier = RT_FALSE;
+            if (msg_item->deadline != 0)
+            {
+                rt_tick_t deadline = msg_item->timestamp + msg_item->deadline;
+                if (!target_node->exec_urgent || EBUS_DEADLINE_BEFORE(deadline, target_node->exec_deadline))
+                {
+                    target_node->exec_deadline = deadline;
+                    target_node->exec_urgent = 1;
+                    earlier = RT_TRUE;
+                }
+            }
+            EbusExecSchedule(target_node, earlier);
+        }
+    }
+    else if (result == -RT_EFULL)
+    {
+        stat->queue_full_cnt++;
+    }
+    return result;
+}
+
+/**
+ * @description: 持有读锁时按目标句柄投递消息，可在中断中调用
+ * @param {sEbusMsgItem_t} *msg_item
+ * @return {*}
+ */
+static eEbusRst_t EbusMsgRouteLocked(const sEbusMsgItem_t *msg_item)
+{
+    if (msg_item->dst_node_idx == EBUS_NODE_IDX_BROADCAST)
+    {
+        for (int i = 0; i < g_ebus_.slot_cap; i++)
+        {
+            sEbusNode_t *target_node = g_ebus_.node_tbl[i];
+            if (target_node != RT_NULL && target_node->init && target_node->node_idx != msg_item->src_node_idx)
+            {
+                EbusMsgPut(target_node, msg_item);
+            }
+        }
+        return eEbusRst_Success;
+    }
+
+    sEbusNode_t *target_node = EbusFindNodeByIdxLocked(msg_item->dst_node_idx);
+    if (target_node == RT_NULL)
+    {
+        return eEbusRst_NodeNotFound;
+    }
+
+    rt_err_t result = EbusMsgPut(target_node, msg_item);
+    if (result == RT_EOK)
+    {
+        return eEbusRst_Success;
+    }
+    return (result == -RT_EFULL) ? eEbusRst_QueueFull : eEbusRst_ParamErr;
+}
+
+/**
+ * @description: 消息写入中断暂存环，多生产者无锁
+ * @param {sEbusIsrRing_t} *ring
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*} 暂存环满返回RT_FALSE
+ */
+static rt_bool_t EbusIsrRingPush(sEbusIsrRing_t *ring, const sEbusMsgItem_t *msg)
+{
+    rt_atomic_t pos = rt_atomic_load(&ring->head);
+
+    while (1)
+    {
+        sEbusIsrCell_t *cell = &ring->cell[pos & (EBUS_ISR_RING_SIZE - 1)];
+        rt_atomic_t diff = rt_atomic_load(&cell->seq) - pos;
+        if (diff == 0)
+        {
+            // 抢占单元，失败时pos更新为最新入队位置
+            if (rt_atomic_compare_exchange_strong(&ring->head, &pos, pos + 1))
+            {
+                rt_memcpy(&cell->msg, msg, EBUS_MSG_ITEM_SIZE(msg->len));
+                rt_atomic_store(&cell->seq, pos + 1);
+                return RT_TRUE;
+            }
+        }
+        else if (diff < 0)
+        {
+            return RT_FALSE;
+        }
+        else
+        {
+            pos = rt_atomic_load(&ring->head);
+        }
+    }
+}
+
+/**
+ * @description: 暂存环中是否有已写完的消息
+ * @param {sEbusIsrRing_t} *ring
+ * @return {*}
+ */
+static rt_bool_t EbusIsrRingPending(sEbusIsrRing_t *ring)
+{
+    rt_atomic_t pos = rt_atomic_load(&ring->tail);
+
+    return rt_atomic_load(&ring->cell[pos & (EBUS_ISR_RING_SIZE - 1)].seq) == pos + 1;
+}
+
+/**
+ * @description: 从暂存环取出一条消息，只能由持有draining的转发者调用
+ * @param {sEbusIsrRing_t} *ring
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+static rt_bool_t EbusIsrRingPop(sEbusIsrRing_t *ring, sEbusMsgItem_t *msg)
+{
+    rt_atomic_t pos = rt_atomic_load(&ring->tail);
+    sEbusIsrCell_t *cell = &ring->cell[pos & (EBUS_ISR_RING_SIZE - 1)];
+
+    if (rt_atomic_load(&cell->seq) != pos + 1)
+    {
+        return RT_FALSE;
+    }
+    rt_memcpy(msg, &cell->msg, EBUS_MSG_ITEM_SIZE(cell->msg.len));
+    rt_atomic_store(&cell->seq, pos + EBUS_ISR_RING_SIZE);
+    rt_atomic_store(&ring->tail, pos + 1);
+    return RT_TRUE;
+}
+
+/**
+ * @description: 转发一个暂存环中的消息，有写者时留给写者解锁后转发，可在中断中调用
+ * @param {sEbusIsrRing_t} *ring
+ * @return {*}
+ */
+static void EbusIsrRingDrainOne(sEbusIsrRing_t *ring)
+{
+    sEbusMsgItem_t msg;
+
+    while (EbusIsrRingPending(ring))
+    {
+        // 同一时刻每个暂存环只有一个转发者，其退出前会再次检查暂存环
+        if (rt_atomic_flag_test_and_set(&ring->draining))
+        {
+            return;
+        }
+        if (!EbusReadTryLock())
+        {
+            rt_atomic_flag_clear(&ring->draining);
+            return;
+        }
+        while (EbusIsrRingPop(ring, &msg))
+        {
+            EbusMsgRouteLocked(&msg);
+        }
+        EbusReadUnlock();
+        rt_atomic_flag_clear(&ring->draining);
+    }
+}
+
+/**
+ * @description: 转发各核暂存环中的消息，写者解锁时调用
+ * @return {*}
+ */
+static void EbusIsrRingDrain(void)
+{
+    for (int i = 0; i < EBUS_CPU_NUM; i++)
+    {
+        EbusIsrRingDrainOne(&g_ebus_.isr_ring[i]);
+    }
+}
+
+/**
+ * @description: 判断通知能否直接调用目标回调，可以时标记目标进入直接回调；发送节点也属于本线程且
+ *               不在调用链上时一并标记，回调链中发回发送节点的通知入队
+ * @param {sEbusNode_t} *node 发送节点
+ * @param {sEbusNode_t} *target_node 目标节点
+ * @param {rt_bool_t} *mark_src 输出是否标记了发送节点，回调返回后由调用者清除
+ * @return {*}
+ */
+static rt_bool_t EbusDirectEnter(sEbusNode_t *node, sEbusNode_t *target_node, rt_bool_t *mark_src)
+{
+    if (!(target_node->flag & EBUS_NODE_FLAG_DIRECT) || target_node->Evtcb == RT_NULL)
+    {
+        return RT_FALSE;
+    }
+    // 只在目标所属线程内直接调用，其他线程仍经队列
+    if (target_node->direct_owner != rt_thread_self())
+    {
+        return RT_FALSE;
+    }
+    // 目标正在处理消息或已在调用链上时入队，避免重入
+    if (target_node->recv_busy || target_node->direct_depth != 0)
+    {
+        return RT_FALSE;
+    }
+    // 队列中还有消息时入队，保持先后顺序
+    if (target_node->msg_queue->entry != 0)
+    {
+        return RT_FALSE;
+    }
+    uint8_t depth = node->direct_depth + 1;
+    if (depth > EBUS_DIRECT_MAX_DEPTH)
+    {
+        return RT_FALSE;
+    }
+    *mark_src = (node->direct_depth == 0 && (node->flag & EBUS_NODE_FLAG_DIRECT) &&
+                 node->direct_owner == rt_thread_self()) ? RT_TRUE : RT_FALSE;
+    if (*mark_src)
+    {
+        node->direct_depth = depth;
+    }
+    target_node->direct_depth = depth;
+    return RT_TRUE;
+}
+
+/**
+ * @description: 查找事件属性，属性表只追加或更新单个字段，可无锁读取
+ * @param {uint16_t} evt_id
+ * @return {*} 未配置返回RT_NULL
+ */
+static sEbusEvtAttr_t *EbusEvtAttrFind(uint16_t evt_id)
+{
+    for (int i = 0; i < g_ebus_.evt_attr_num; i++)
+    {
+        if (g_ebus_.evt_attr[i].evt_id == evt_id)
+        {
+            return &g_ebus_.evt_attr[i];
+        }
+    }
+    return RT_NULL;
+}
+
+/**
+ * @description: 消息未指定截止时间、有效期时按事件属性填充
+ * @param {sEbusMsgItem_t} *msg_item
+ * @return {*}
+ */
+static void EbusEvtAttrApply(sEbusMsgItem_t *msg_item)
+{
+    if (msg_item->deadline != 0 && msg_item->ttl != 0)
+    {
+        return;
+    }
+    sEbusEvtAttr_t *attr = EbusEvtAttrFind(msg_item->evt_id);
+    if (attr != RT_NULL)
+    {
+        if (msg_item->deadline == 0)
+        {
+            msg_item->deadline = attr->deadline;
+        }
+        if (msg_item->ttl == 0)
+        {
+            msg_item->ttl = attr->ttl;
+        }
+    }
+}
+
+/**
+ * @description: 补充令牌并计算还需等待的tick数，调用者需持有令牌桶锁
+ * @param {sEbusRate_t} *rate 为RT_NULL时不限流
+ * @param {rt_tick_t} now
+ * @return {*} 0表示至少有一个令牌
+ */
+static rt_tick_t EbusRateRefillLocked(sEbusRate_t *rate, rt_tick_t now)
+{
+    if (rate == RT_NULL)
+    {
+        return 0;
+    }
+
+    // 令牌放大RT_TICK_PER_SECOND倍，按tick整数补充
+    uint32_t full = (uint32_t)rate->burst * RT_TICK_PER_SECOND;
+    rt_tick_t elapsed = now - rate->last;
+    rate->last = now;
+    if (elapsed > (full - rate->tokens) / rate->rate)
+    {
+        rate->tokens = full;
+    }
+    else
+    {
+        rate->tokens += elapsed * rate->rate;
+    }
+
+    if (rate->tokens >= RT_TICK_PER_SECOND)
+    {
+        return 0;
+    }
+    return (RT_TICK_PER_SECOND - rate->tokens + rate->rate - 1) / rate->rate;
+}
+
+/**
+ * @description: 锁住参与限流的令牌桶，先锁节点桶再锁事件桶，顺序固定不会死锁
+ * @param {sEbusRate_t} *node_rate 可为RT_NULL
+ * @param {sEbusRate_t} *evt_rate 可为RT_NULL，不能与node_rate同时为RT_NULL
+ * @return {*}
+ */
+static rt_base_t EbusRateLock(sEbusRate_t *node_rate, sEbusRate_t *evt_rate)
+{
+    rt_base_t level = rt_spin_lock_irqsave((node_rate != RT_NULL) ? &node_rate->lock : &evt_rate->lock);
+    if (node_rate != RT_NULL && evt_rate != RT_NULL)
+    {
+        rt_spin_lock(&evt_rate->lock);
+    }
+    return level;
+}
+
+/**
+ * @description: 解锁EbusRateLock锁住的令牌桶
+ * @param {sEbusRate_t} *node_rate
+ * @param {sEbusRate_t} *evt_rate
+ * @param {rt_base_t} level
+ * @return {*}
+ */
+static void EbusRateUnlock(sEbusRate_t *node_rate, sEbusRate_t *evt_rate, rt_base_t level)
+{
+    if (node_rate != RT_NULL && evt_rate != RT_NULL)
+    {
+        rt_spin_unlock(&evt_rate->lock);
+    }
+    rt_spin_unlock_irqrestore((node_rate != RT_NULL) ? &node_rate->lock : &evt_rate->lock, level);
+}
+
+/**
+ * @description: 从发送节点和事件的令牌桶各取一个令牌，两者都有令牌才放行
+ * @param {sEbusNode_t} *node
+ * @param {uint16_t} evt_id
+ * @param {rt_bool_t} can_wait 是否允许按延迟策略阻塞
+ * @param {eEbusRatePolicy_t} *policy 未放行时输出限流的策略
+ * @return {*}
+ */
+static rt_bool_t EbusRateAcquire(sEbusNode_t *node, uint16_t evt_id, rt_bool_t can_wait, eEbusRatePolicy_t *policy)
+{
+    sEbusEvtAttr_t *attr = EbusEvtAttrFind(evt_id);
+    rt_bool_t counted = RT_FALSE;
+
+    for (;;)
+    {
+        // 锁外的判断只决定锁哪些桶，各桶只有自己的锁，不同节点、不同事件的发送互不争用
+        sEbusRate_t *node_lock = (node->rate.rate != 0) ? &node->rate : RT_NULL;
+        sEbusRate_t *evt_lock = (attr != RT_NULL && attr->rate.rate != 0) ? &attr->rate : RT_NULL;
+        if (node_lock == RT_NULL && evt_lock == RT_NULL)
+        {
+            return RT_TRUE;
+        }
+
+        // 参与补充的桶在锁内重新确认，避免与并发的设置为0竞争而除零
+        rt_base_t level = EbusRateLock(node_lock, evt_lock);
+        sEbusRate_t *node_rate = (node_lock != RT_NULL && node_lock->rate != 0) ? node_lock : RT_NULL;
+        sEbusRate_t *evt_rate = (evt_lock != RT_NULL && evt_lock->rate != 0) ? evt_lock : RT_NULL;
+        rt_tick_t now = rt_tick_get();
+        rt_tick_t node_wait = EbusRateRefillLocked(node_rate, now);
+        rt_tick_t evt_wait = EbusRateRefillLocked(evt_rate, now);
+        if (node_wait == 0 && evt_wait == 0)
+        {
+            if (node_rate != RT_NULL)
+            {
+                node_rate->tokens -= RT_TICK_PER_SECOND;
+            }
+            if (evt_rate != RT_NULL)
+            {
+                evt_rate->tokens -= RT_TICK_PER_SECOND;
+            }
+            EbusRateUnlock(node_lock, evt_lock, level);
+            return RT_TRUE;
+        }
+
+        // 按令牌不足的桶处理，两者都不足时取等待更久的
+        sEbusRate_t *limiter = (node_wait >= evt_wait) ? node_rate : evt_rate;
+        rt_tick_t wait = (node_wait >= evt_wait) ? node_wait : evt_wait;
+        *policy = (eEbusRatePolicy_t)limiter->policy;
+        if (*policy == eEbusRatePolicy_Delay && !can_wait)
+        {
+            *policy = eEbusRatePolicy_Reject;
+        }
+        if (!counted)
+        {
+            limiter->limited_cnt++;
+            counted = RT_TRUE;
+        }
+        EbusRateUnlock(node_lock, evt_lock, level);
+
+        if (*policy != eEbusRatePolicy_Delay)
+        {
+            return RT_FALSE;
+        }
+        rt_thread_delay(wait);
+    }
+}
+
+/**
+ * @description: 消息发送
+ * @param {sEbusNode_t} *node
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+static eEbusRst_t EbusMsgSend(sEbusNode_t *node, sEbusMsgItem_t *msg_item)
+{
+    if (node == RT_NULL || !node->init || msg_item == RT_NULL || msg_item->len > EBUS_MAX_MSG_SIZE)
+    {
+        LOG_E("[Ebus] Message send parameter error: node=%p, msg=%p", node, msg_item);
+        return eEbusRst_ParamErr;
+    }
+
+    EbusEvtAttrApply(msg_item);
+
+    // 响应不限流，避免请求方等待超时
+    eEbusRatePolicy_t policy;
+    if (msg_item->type != eEbusMsgType_Response && !EbusRateAcquire(node, msg_item->evt_id, RT_TRUE, &policy))
+    {
+        LOG_D("[Ebus] Message rate limited: src=%s, evt=%x, policy=%d", node->name, msg_item->evt_id, policy);
+        if (policy == eEbusRatePolicy_Drop && msg_item->type != eEbusMsgType_Indication)
+        {
+            return eEbusRst_Success;
+        }
+        return eEbusRst_RateLimited;
+    }
+
+    LOG_D("[Ebus] Sending message: type=%d, src=%d, dst=%d, seq=%d",
+          msg_item->type, msg_item->src_node_idx, msg_item->dst_node_idx, msg_item->seq_num);
+
+    switch (msg_item->type)
+    {
+    case eEbusMsgType_Broadcast:
+    {
+            /* 广播消息：发送给所有已注册的节点（除了自己） */
+        int send_count = 0;
+        EbusReadLock();
+        for (int i = 0; i < g_ebus_.slot_cap; i++)
+        {
+            sEbusNode_t *target_node = g_ebus_.node_tbl[i];
+            if (target_node != RT_NULL && target_node->init && target_node != node)
+            {
+                rt_err_t result = EbusMsgPut(target_node, msg_item);
+                if (result == RT_EOK)
+                {
+                    send_count++;
+                    LOG_D("[Ebus] Broadcast sent to node: %s", target_node->name);
+                }
+                else if (result == -RT_EFULL)
+                {
+                    LOG_W("[Ebus] Node %s message queue full, drop broadcast", target_node->name);
+                }
+                else
+                {
+                    LOG_E("[Ebus] Send broadcast to node %s failed: %d", target_node->name, result);
+                }
+            }
+        }
+        EbusReadUnlock();
+        LOG_D("[Ebus] Broadcast completed: src=%d, seq=%d, sent_to=%d nodes",
+              msg_item->src_node_idx, msg_item->seq_num, send_count);
+    }
+    break;
+
+    case eEbusMsgType_Multicast:
+    {
+        /* 组播消息：按成员句柄逐个入队（除了自己），失效的句柄跳过 */
+        int send_count = 0;
+        EbusReadLock();
+        uint16_t group_no = EBUS_GROUP_IDX_SLOT(msg_item->dst_node_idx);
+        sEbusGroup_t *group = (group_no < EBUS_GROUP_NUM) ? &g_ebus_.group[group_no] : RT_NULL;
+        if (group == RT_NULL || !group->used || group->gen != EBUS_GROUP_IDX_GEN(msg_item->dst_node_idx))
+        {
+            EbusReadUnlock();
+            LOG_E("[Ebus] Multicast group not found: idx=0x%04X", msg_item->dst_node_idx);
+            return eEbusRst_NodeNotFound;
+        }
+        for (int i = 0; i < group->member_num; i++)
+        {
+            sEbusNode_t *target_node = EbusFindNodeByIdxLocked(group->member[i]);
+            if (target_node != RT_NULL && target_node != node)
+            {
+                rt_err_t result = EbusMsgPut(target_node, msg_item);
+                if (result == RT_EOK)
+                {
+                    send_count++;
+                }
+                else if (result == -RT_EFULL)
+                {
+                    LOG_W("[Ebus] Node %s message queue full, drop multicast", target_node->name);
+                }
+            }
+        }
+        EbusReadUnlock();
+        LOG_D("[Ebus] Multicast completed: src=%d, seq=%d, sent_to=%d nodes",
+              msg_item->src_node_idx, msg_item->seq_num, send_count);
+    }
+    break;
+
+    case eEbusMsgType_Response:
+    case eEbusMsgType_Notification:
+    case eEbusMsgType_Indication:
+    {
+        // 持有读锁直到入队完成，避免目标节点在发送途中被销毁
+        eEbusRst_t rst = eEbusRst_Success;
+        rt_bool_t mark_src = RT_FALSE;
+        EbusReadLock();
+        sEbusNode_t *target_node = EbusFindNodeByIdxLocked(msg_item->dst_node_idx);
+        if (target_node != RT_NULL && msg_item->type == eEbusMsgType_Notification &&
+            msg_item->len <= target_node->msg_size && EbusFilterPass(target_node, msg_item) &&
+            EbusDirectEnter(node, target_node, &mark_src))
+        {
+            if (msg_item->len > target_node->stat.msg_len_hwm)
+            {
+                target_node->stat.msg_len_hwm = msg_item->len;
+            }
+            // 目标与发送者同线程，引用目标后释放读锁直接调用，回调中可以再次发送或创建节点；
+            // 销毁目标时等待引用归零
+            rt_atomic_add(&target_node->direct_ref, 1);
+            EbusReadUnlock();
+            target_node->Evtcb(eEbusEvtType_RecvCb, target_node, msg_item, RT_NULL);
+            target_node->direct_depth = 0;
+            if (mark_src)
+            {
+                node->direct_depth = 0;
+            }
+            // 引用归零后不再访问目标，唤醒等待的销毁者
+            if (rt_atomic_sub(&target_node->direct_ref, 1) == 1 && rt_atomic_load(&g_ebus_.direct_wait) != 0)
+            {
+                EbusWakeWaiters(&g_ebus_.direct_wait, &g_ebus_.direct_sem);
+            }
+            return eEbusRst_Success;
+        }
+        if (target_node != RT_NULL)
+        {
+            rt_err_t result = EbusMsgPut(target_node, msg_item);
+            if (result == RT_EOK)
+            {
+                LOG_D("[Ebus] Message sent: type=%d, src=%d->%s, dst=%d->%s, seq=%x, evt=%x, len=%d",
+                      msg_item->type,
+                      msg_item->src_node_idx, node->name,
+                      msg_item->dst_node_idx, target_node->name,
+                      msg_item->seq_num, msg_item->evt_id, msg_item->len);
+            }
+            else if (result == -RT_EFULL)
+            {
+                LOG_E("[Ebus] Target node %s message queue full, drop message", target_node->name);
+                rst = eEbusRst_QueueFull;
+            }
+            else if (result == -RT_EINVAL)
+            {
+                rst = eEbusRst_ParamErr;
+            }
+            else
+            {
+                LOG_E("[Ebus] Send to node %s failed: %d", target_node->name, result);
+                rst = eEbusRst_Fail;
+            }
+        }
+        else
+        {
+            LOG_E("[Ebus] Target node not found: idx=%d", msg_item->dst_node_idx);
+            rst = eEbusRst_NodeNotFound;
+        }
+        EbusReadUnlock();
+        if (rst != eEbusRst_Success)
+        {
+            return rst;
+        }
+    }
+    break;
+
+    default:
+        LOG_E("[Ebus] Unknown message type: %d", msg_item->type);
+        return eEbusRst_ParamErr;
+    }
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 总线创建，总线结构与互斥量均为静态存储
+ * @return {*} 本次调用创建了总线返回RT_TRUE，总线已存在返回RT_FALSE
+ */
+rt_bool_t EbusCreate(void)
+{
+    if (g_ebus_.init)
+    {
+        LOG_W("[Ebus] Bus already initialized");
+        return RT_FALSE;
+    }
+
+    LOG_D("[Ebus] Creating ebus...");
+    rt_memset(&g_ebus_, 0x00, sizeof(g_ebus_));
+    g_ebus_.init = 1;
+    g_ebus_.node_len = 0;
+    g_ebus_.node_tbl = g_ebus_.node_static;
+    g_ebus_.slot_tbl = g_ebus_.slot_static;
+    g_ebus_.slot_cap = EBUS_MAX_NODE_NUM;
+    g_ebus_.free_head = 0;
+    for (int cpu = 0; cpu < EBUS_CPU_NUM; cpu++)
+    {
+        for (int i = 0; i < EBUS_ISR_RING_SIZE; i++)
+        {
+            rt_atomic_store(&g_ebus_.isr_ring[cpu].cell[i].seq, i);
+        }
+    }
+    for (int i = 0; i < EBUS_MAX_NODE_NUM; i++)
+    {
+        g_ebus_.slot_static[i].free_next = EBUS_NODE_IDX_MAKE((i + 1 < EBUS_MAX_NODE_NUM) ? (i + 1) : EBUS_NODE_SLOT_NONE, 0);
+        g_ebus_.slot_static[i].hash_head = EBUS_NODE_SLOT_NONE;
+    }
+    rt_mutex_init(&g_ebus_.bus_lock.writer_mutex, "ebusmtx", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&g_ebus_.bus_lock.drain_sem, "ebussem", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&g_ebus_.direct_sem, "ebusdir", 0, RT_IPC_FLAG_PRIO);
+    rt_spin_lock_init(&g_ebus_.gather_lock);
+    rt_spin_lock_init(&g_ebus_.retry_lock);
+    rt_memset(&g_ebus_tmr_, 0x00, sizeof(g_ebus_tmr_));
+    rt_spin_lock_init(&g_ebus_tmr_.lock);
+    rt_timer_init(&g_ebus_tmr_.timer, "ebustmr", EbusTimerTick, RT_NULL, 1, EBUS_TIMER_FLAG);
+    LOG_D("[Ebus] Ebus created successfully");
+    return RT_TRUE;
+}
+
+/**
+ * @description: 总线销毁
+ * @return {*}
+ */
+void EbusDestory(void)
+{
+    if (!g_ebus_.init)
+    {
+        LOG_W("[Ebus] Bus not initialized, skip destroy");
+        return;
+    }
+
+    LOG_D("[Ebus] Destroying ebus...");
+
+    rt_timer_stop(&g_ebus_tmr_.timer);
+    rt_timer_detach(&g_ebus_tmr_.timer);
+    g_ebus_tmr_.running = 0;
+
+    rt_sem_detach(&g_ebus_.bus_lock.drain_sem);
+    rt_sem_detach(&g_ebus_.direct_sem);
+    rt_mutex_detach(&g_ebus_.bus_lock.writer_mutex);
+    LOG_D("[Ebus] Bus lock detached");
+
+    if (g_ebus_.node_tbl != RT_NULL && g_ebus_.node_tbl != g_ebus_.node_static)
+    {
+        rt_free(g_ebus_.node_tbl);
+        LOG_D("[Ebus] Node table freed");
+    }
+
+    g_ebus_.init = 0;
+    rt_memset(&g_ebus_, 0x00, sizeof(g_ebus_));
+    LOG_D("[Ebus] Ebus destroyed successfully");
+}
+
+/**
+ * @description: 补全节点容量配置，未指定项取默认值
+ * @param {sEbusNodeCfg_t} *cfg 用户配置，可为RT_NULL
+ * @param {sEbusNodeCfg_t} *out
+ * @return {*} 配置合法返回RT_TRUE
+ */
+static rt_bool_t EbusNodeCfgResolve(const sEbusNodeCfg_t *cfg, sEbusNodeCfg_t *out)
+{
+    out->msg_num = EBUS_MAX_MSG_NUM;
+    out->msg_size = EBUS_MAX_MSG_SIZE;
+    out->resp_wait_num = EBUS_NODE_MAX_RESP_WAIT_NUM;
+    if (cfg != RT_NULL)
+    {
+        if (cfg->msg_num)
+        {
+            out->msg_num = cfg->msg_num;
+        }
+        if (cfg->msg_size)
+        {
+            out->msg_size = cfg->msg_size;
+        }
+        if (cfg->resp_wait_num)
+        {
+            out->resp_wait_num = cfg->resp_wait_num;
+        }
+    }
+    return out->msg_size <= EBUS_MAX_MSG_SIZE;
+}
+
+/**
+ * @description: 在给定存储上初始化节点并注册到总线，不做任何堆分配
+ * @param {sEbusNode_t} *node 节点存储
+ * @param {char} *name
+ * @param {EbusCbPtr} EvtCb
+ * @param {sEbusNodeCfg_t} *cfg 已补全的容量配置
+ * @param {void} *storage 节点缓冲区，依次存放消息队列与等待响应列表
+ * @param {uint8_t} flag 节点标志
+ * @return {*}
+ */
+static eEbusRst_t EbusNodeSetup(sEbusNode_t *node, char *name, EbusCbPtr EvtCb,
+                                const sEbusNodeCfg_t *cfg, void *storage, uint8_t flag)
+{
+    rt_size_t pool_size = RT_MQ_BUF_SIZE(EBUS_MSG_ITEM_SIZE(cfg->msg_size), cfg->msg_num);
+
+    rt_memset(node, 0, sizeof(sEbusNode_t));
+
+    rt_strncpy(node->name, name, EBUS_NAME_LEN - 1);
+    node->name[EBUS_NAME_LEN - 1] = '\0';
+    node->Evtcb = EvtCb;
+    node->flag = flag;
+    node->msg_size = cfg->msg_size;
+    node->home_cpu = EBUS_CPU_ANY;
+    rt_spin_lock_init(&node->rate.lock);
+
+    // 初始化等待响应列表
+    // 等待响应列表从新的缓存行开始，与生产者写入的队列缓冲区分开
+    node->wait_resp_list = (sEbusWaitResp_t *)((uint8_t *)storage + EBUS_NODE_MQ_POOL_SIZE(cfg->msg_num, cfg->msg_size));
+    node->wait_resp_num = cfg->resp_wait_num;
+    for (int i = 0; i < node->wait_resp_num; i++)
+    {
+        rt_memset(&node->wait_resp_list[i], 0, sizeof(sEbusWaitResp_t));
+        node->wait_resp_list[i].state = eEbusMsgState_Idle;
+    }
+
+    // 初始化响应互斥量
+    rt_mutex_init(&node->resp_mutex_obj, "respmtx", RT_IPC_FLAG_FIFO);
+    node->resp_mutex = &node->resp_mutex_obj;
+
+    // 初始化消息队列
+    char mq_name[EBUS_NAME_LEN] = { 0 };
+    rt_snprintf(mq_name, EBUS_NAME_LEN, "%s_mq", name);
+    if (rt_mq_init(&node->msg_queue_obj, mq_name, storage, EBUS_MSG_ITEM_SIZE(cfg->msg_size),
+                   pool_size, RT_IPC_FLAG_FIFO) != RT_EOK)
+    {
+        LOG_E("[Ebus] Failed to init message queue for node: %s", name);
+        rt_mutex_detach(node->resp_mutex);
+        return eEbusRst_Fail;
+    }
+    node->msg_queue = &node->msg_queue_obj;
+
+    // 注册到总线
+    rt_err_t result = EbusBusInit(node);
+    if (result != RT_EOK)
+    {
+        LOG_E("[Ebus] Failed to register node: %s, err=%d", name, result);
+        rt_mq_detach(node->msg_queue);
+        rt_mutex_detach(node->resp_mutex);
+        return (result == -RT_EBUSY) ? eEbusRst_NameCollision : eEbusRst_NoMemory;
+    }
+
+    LOG_D("[Ebus] Node created successfully: name=%s, idx=0x%04X, msg=%dx%d, resp=%d",
+          node->name, node->node_idx, cfg->msg_num, cfg->msg_size, cfg->resp_wait_num);
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 根据名称查找节点
+ * @param {char} *name
+ * @return {*} 未找到返回RT_NULL
+ */
+sEbusNode_t *EbusNodeFind(const char *name)
+{
+    if (name == RT_NULL)
+    {
+        return RT_NULL;
+    }
+    return EbusFindNodeByName(name);
+}
+
+/**
+ * @description: 总线内节点创建，使用默认容量
+ * @param {char} *name
+ * @param {EbusCbPtr} EvtCb
+ * @return {*}
+ */
+sEbusNode_t *EbusNodeCreate(char *name, EbusCbPtr EvtCb)
+{
+    return EbusNodeCreateEx(name, EvtCb, RT_NULL);
+}
+
+/**
+ * @description: 总线内节点创建，按配置指定队列深度、消息长度和等待响应数量，节点与缓冲区一次分配
+ * @param {char} *name
+ * @param {EbusCbPtr} EvtCb
+ * @param {sEbusNodeCfg_t} *cfg 容量配置，RT_NULL或0项使用默认值
+ * @return {*}
+ */
+sEbusNode_t *EbusNodeCreateEx(char *name, EbusCbPtr EvtCb, const sEbusNodeCfg_t *cfg)
+{
+    sEbusNodeCfg_t node_cfg;
+
+    if (name == RT_NULL || EvtCb == RT_NULL || !EbusNodeCfgResolve(cfg, &node_cfg))
+    {
+        LOG_E("[Ebus] Invalid parameters for node creation");
+        return RT_NULL;
+    }
+
+    LOG_D("[Ebus] Creating node: %s", name);
+
+    rt_size_t node_size = RT_ALIGN(sizeof(sEbusNode_t), RT_ALIGN_SIZE);
+    rt_size_t storage_size = EBUS_NODE_STORAGE_SIZE(node_cfg.msg_num, node_cfg.msg_size, node_cfg.resp_wait_num);
+    sEbusNode_t *node = (sEbusNode_t *)EBUS_NODE_MALLOC(node_size + storage_size);
+    if (node == RT_NULL)
+    {
+        LOG_E("[Ebus] Failed to allocate memory for node: %s", name);
+        return RT_NULL;
+    }
+
+    if (EbusNodeSetup(node, name, EvtCb, &node_cfg, (uint8_t *)node + node_size, 0) != eEbusRst_Success)
+    {
+        EBUS_NODE_FREE(node);
+        return RT_NULL;
+    }
+    return node;
+}
+
+/**
+ * @description: 使用调用者提供的存储初始化节点，节点销毁时不释放存储
+ * @param {sEbusNode_t} *node 节点存储
+ * @param {char} *name
+ * @param {EbusCbPtr} EvtCb
+ * @param {void} *storage 节点缓冲区，按RT_ALIGN_SIZE对齐
+ * @param {rt_size_t} storage_size 缓冲区大小，见EBUS_NODE_POOL_SIZE
+ * @return {*}
+ */
+eEbusRst_t EbusNodeInit(sEbusNode_t *node, char *name, EbusCbPtr EvtCb, void *storage, rt_size_t storage_size)
+{
+    return EbusNodeInitEx(node, name, EvtCb, RT_NULL, storage, storage_size);
+}
+
+/**
+ * @description: 使用调用者提供的存储按配置初始化节点
+ * @param {sEbusNode_t} *node 节点存储
+ * @param {char} *name
+ * @param {EbusCbPtr} EvtCb
+ * @param {sEbusNodeCfg_t} *cfg 容量配置，RT_NULL或0项使用默认值
+ * @param {void} *storage 节点缓冲区，按RT_ALIGN_SIZE对齐
+ * @param {rt_size_t} storage_size 缓冲区大小，见EBUS_NODE_STORAGE_SIZE
+ * @return {*}
+ */
+eEbusRst_t EbusNodeInitEx(sEbusNode_t *node, char *name, EbusCbPtr EvtCb, const sEbusNodeCfg_t *cfg,
+                          void *storage, rt_size_t storage_size)
+{
+    sEbusNodeCfg_t node_cfg;
+
+    if (node == RT_NULL || name == RT_NULL || EvtCb == RT_NULL || storage == RT_NULL ||
+        !EbusNodeCfgResolve(cfg, &node_cfg) ||
+        storage_size < EBUS_NODE_STORAGE_SIZE(node_cfg.msg_num, node_cfg.msg_size, node_cfg.resp_wait_num))
+    {
+        LOG_E("[Ebus] Invalid parameters for node init");
+        return eEbusRst_ParamErr;
+    }
+
+    LOG_D("[Ebus] Initializing static node: %s", name);
+    return EbusNodeSetup(node, name, EvtCb, &node_cfg, storage, EBUS_NODE_FLAG_STATIC);
+}
+
+/**
+ * @description: 根据运行期统计给出节点容量建议
+ * @param {sEbusNode_t} *node
+ * @param {sEbusNodeCfg_t} *hint 建议的容量配置
+ * @return {*}
+ */
+void EbusNodeSizingHint(sEbusNode_t *node, sEbusNodeCfg_t *hint)
+{
+    if (node == RT_NULL || !node->init || hint == RT_NULL)
+    {
+        return;
+    }
+
+    const sEbusNodeStat_t *stat = &node->stat;
+    uint32_t msg_num = node->msg_queue->max_msgs;
+    uint32_t num;
+
+    // 出现过丢弃说明容量不足，翻倍；否则在最高水位上留25%余量。按32位计算后限制在uint16_t内，避免建议值回绕变小
+    if (stat->queue_full_cnt)
+    {
+        num = msg_num * 2;
+    }
+    else
+    {
+        num = (uint32_t)stat->msg_hwm + (stat->msg_hwm >> 2) + 1;
+    }
+    hint->msg_num = (num > UINT16_MAX) ? UINT16_MAX : (uint16_t)num;
+
+    if (stat->resp_full_cnt)
+    {
+        num = (uint32_t)node->wait_resp_num * 2;
+    }
+    else
+    {
+        num = (uint32_t)stat->resp_wait_hwm + (stat->resp_wait_hwm >> 2) + 1;
+    }
+    hint->resp_wait_num = (num > UINT16_MAX) ? UINT16_MAX : (uint16_t)num;
+
+    hint->msg_size = stat->msg_len_hwm ? stat->msg_len_hwm : 1;
+}
+
+/**
+ * @description: 总线内节点销毁，静态节点只注销不释放存储
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+void EbusNodeDestory(sEbusNode_t *node)
+{
+    if (node == RT_NULL)
+    {
+        LOG_E("[Ebus] Attempt to destroy null node");
+        return;
+    }
+
+    if (!node->init)
+    {
+        LOG_W("[Ebus] Node not initialized: %s", node->name);
+        return;
+    }
+
+    if (EbusExecInSelf(node))
+    {
+        LOG_E("[Ebus] Node %s cannot be destroyed in its own executor callback", node->name);
+        return;
+    }
+
+    if (node->direct_depth != 0 && node->direct_owner == rt_thread_self())
+    {
+        LOG_E("[Ebus] Node %s cannot be destroyed in its direct call chain", node->name);
+        return;
+    }
+
+    LOG_D("[Ebus] Destroying node: %s, idx=0x%04X", node->name, node->node_idx);
+
+    // 取消本节点的定时发布
+    EbusTimerCancelNode(node);
+
+    // 从总线注销
+    EbusBusDeinit(node);
+
+    // 注销后发送方不能再找到本节点，再等待执行器中的回调结束，之后不会有新的调度
+    EbusExecDetach(node);
+
+    // 注销后也不会有新的直接回调，等待其他线程中正在进行的直接回调返回
+    while (rt_atomic_load(&node->direct_ref) != 0)
+    {
+        // 先登记再检查，发送方释放引用后必然看到登记
+        rt_atomic_add(&g_ebus_.direct_wait, 1);
+        if (rt_atomic_load(&node->direct_ref) != 0)
+        {
+            rt_sem_take(&g_ebus_.direct_sem, RT_WAITING_FOREVER);
+        }
+    }
+
+    // 释放全部未完成的等待项：归还信用、重传表项和汇聚指示，并按超时通知请求方，使其释放上下文
+    for (int i = 0; i < node->wait_resp_num; i++)
+    {
+        sEbusWaitResp_t item = node->wait_resp_list[i];
+        if (item.state == eEbusMsgState_Idle)
+        {
+            continue;
+        }
+        EbusFreeWaitRespItem(node, i);
+        if (item.gather != 0)
+        {
+            EbusGatherFinish(node, &g_ebus_.gather[item.gather - 1], eEbusRst_Timeout);
+        }
+        else
+        {
+            EbusWaitRespTimeoutCb(node, &item);
+        }
+    }
+
+    // 脱离消息队列和互斥量
+    rt_mq_detach(node->msg_queue);
+    LOG_D("[Ebus] Message queue detached for node: %s", node->name);
+
+    rt_mutex_detach(node->resp_mutex);
+    LOG_D("[Ebus] Response mutex detached for node: %s", node->name);
+
+    LOG_D("[Ebus] Node destroyed successfully: %s", node->name);
+
+    // 清理节点数据
+    node->node_idx = 0;
+    node->init = 0;
+    if (!(node->flag & EBUS_NODE_FLAG_STATIC))
+    {
+        EBUS_NODE_FREE(node);
+    }
+}
+
+/**
+ * @description: 设置直接投递，需在节点所属线程中调用。开启后本线程发给该节点的通知在发送接口内
+ *               直接以eEbusEvtType_RecvCb调用回调；目标忙、队列非空、超过嵌套深度或跨线程时仍入队
+ * @param {sEbusNode_t} *node
+ * @param {rt_bool_t} enable
+ * @return {*}
+ */
+void EbusNodeSetDirect(sEbusNode_t *node, rt_bool_t enable)
+{
+    if (node == RT_NULL || !node->init)
+    {
+        LOG_E("[Ebus] Invalid node for direct mode");
+        return;
+    }
+
+    if (enable)
+    {
+        node->direct_owner = rt_thread_self();
+        node->flag |= EBUS_NODE_FLAG_DIRECT;
+    }
+    else
+    {
+        node->flag &= ~EBUS_NODE_FLAG_DIRECT;
+        node->direct_owner = RT_NULL;
+    }
+}
+
+/**
+ * @description: 设置节点所属核，挂接执行器的节点下次就绪起只在该核的工作线程上执行；
+ *               不使用执行器的节点由调用者把接收线程绑定到同一核
+ * @param {sEbusNode_t} *node
+ * @param {uint8_t} cpu 核编号，EBUS_CPU_ANY取消指定
+ * @return {*}
+ */
+eEbusRst_t EbusNodeSetCpu(sEbusNode_t *node, uint8_t cpu)
+{
+    if (node == RT_NULL || !node->init || (cpu != EBUS_CPU_ANY && cpu >= EBUS_CPU_NUM))
+    {
+        LOG_E("[Ebus] Invalid parameters for node cpu");
+        return eEbusRst_ParamErr;
+    }
+
+    node->home_cpu = cpu;
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 从工作线程就绪队列取出节点，本线程取队头，窃取时取队尾；跳过取出者不能执行的节点
+ * @param {sEbusExecWorker_t} *victim 就绪队列所属的工作线程
+ * @param {sEbusExecWorker_t} *worker 取出节点的工作线程
+ * @param {rt_bool_t} steal
+ * @return {*}
+ */
+static sEbusNode_t *EbusExecTake(sEbusExecWorker_t *victim, sEbusExecWorker_t *worker, rt_bool_t steal)
+{
+    rt_base_t level = rt_spin_lock_irqsave(&victim->lock);
+    sEbusNode_t *node = steal ? victim->tail : victim->head;
+    while (node != RT_NULL && victim != worker && !EbusExecMayRun(worker, node))
+    {
+        node = steal ? node->exec_prev : node->exec_next;
+    }
+    if (node != RT_NULL)
+    {
+        EbusExecUnlinkLocked(victim, node);
+        rt_atomic_store(&node->exec_state, EBUS_EXEC_STATE_RUNNING);
+    }
+    rt_spin_unlock_irqrestore(&victim->lock, level);
+    return node;
+}
+
+/**
+ * @description: 比较各工作线程队头，取出截止时间最早的节点，保证跨工作线程的最早截止时间优先
+ * @param {sEbusExecWorker_t} *worker
+ * @return {*} 没有带截止时间的就绪节点时返回RT_NULL
+ */
+static sEbusNode_t *EbusExecTakeUrgent(sEbusExecWorker_t *worker)
+{
+    sEbusExecWorker_t *best = RT_NULL;
+    rt_tick_t best_deadline = 0;
+
+    for (int i = 0; i < g_ebus_exec_.worker_num; i++)
+    {
+        sEbusExecWorker_t *victim = &g_ebus_exec_.worker[(worker->id + i) % g_ebus_exec_.worker_num];
+        rt_base_t level = rt_spin_lock_irqsave(&victim->lock);
+        sEbusNode_t *head = victim->head;
+        if (head != RT_NULL && head->exec_linked == EBUS_EXEC_LINK_URGENT && EbusExecMayRun(worker, head) &&
+            (best == RT_NULL || EBUS_DEADLINE_BEFORE(head->exec_deadline, best_deadline)))
+        {
+            best = victim;
+            best_deadline = head->exec_deadline;
+        }
+        rt_spin_unlock_irqrestore(&victim->lock, level);
+    }
+    if (best == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    // 比较后队头可能已被取走，此时取到的是该队列的下一个节点
+    sEbusNode_t *node = EbusExecTake(best, worker, RT_FALSE);
+    if (node != RT_NULL && best != worker)
+    {
+        worker->steal_cnt++;
+    }
+    return node;
+}
+
+/**
+ * @description: 在工作线程上执行节点的一批消息，之后按队列情况重新就绪
+ * @param {sEbusExecWorker_t} *worker
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+static void EbusExecRun(sEbusExecWorker_t *worker, sEbusNode_t *node)
+{
+    sEbusMsgItem_t msg;
+
+    rt_atomic_store(&worker->current, (rt_atomic_t)node);
+    node->exec_worker = worker->id;
+    worker->run_cnt++;
+    // 回调中退出执行器时结束本批，之后不再调度
+    for (int i = 0; i < EBUS_EXEC_BATCH && node->exec_attached; i++)
+    {
+        eEbusRst_t rst = EbusMsgRecv(node, &msg);
+        if (rst == eEbusRst_Success)
+        {
+            node->Evtcb(eEbusEvtType_RecvCb, node, &msg, RT_NULL);
+        }
+        else if (rst != eEbusRst_OtherEvt)
+        {
+            break;
+        }
+    }
+    EbusWaitRespExpire(node);
+
+    // 队列已空时截止时刻失效；先回到空闲再检查队列，执行期间到达的消息不会遗漏
+    if (node->msg_queue->entry == 0)
+    {
+        node->exec_urgent = 0;
+    }
+    rt_atomic_store(&node->exec_state, EBUS_EXEC_STATE_IDLE);
+    if (node->msg_queue->entry != 0)
+    {
+        EbusExecSchedule(node, RT_FALSE);
+    }
+    // 此后工作线程不再访问节点
+    rt_atomic_store(&worker->current, 0);
+    EbusExecDetachWake();
+}
+
+/**
+ * @description: 执行器工作线程，本线程队列为空时从其他工作线程窃取，指定所属核的节点只在本核线程之间窃取
+ * @param {void} *parameter
+ * @return {*}
+ */
+static void EbusExecWorkerEntry(void *parameter)
+{
+    sEbusExecWorker_t *worker = (sEbusExecWorker_t *)parameter;
+    rt_atomic_t bit = (rt_atomic_t)1 << worker->id;
+    rt_bool_t idle = RT_FALSE;
+
+    while (rt_atomic_load(&g_ebus_exec_.running))
+    {
+        sEbusNode_t *node = RT_NULL;
+        if (rt_atomic_load(&g_ebus_exec_.urgent_num) != 0)
+        {
+            node = EbusExecTakeUrgent(worker);
+        }
+        if (node == RT_NULL)
+        {
+            node = EbusExecTake(worker, worker, RT_FALSE);
+        }
+        for (int i = 1; node == RT_NULL && i < g_ebus_exec_.worker_num; i++)
+        {
+            sEbusExecWorker_t *victim = &g_ebus_exec_.worker[(worker->id + i) % g_ebus_exec_.worker_num];
+            node = EbusExecTake(victim, worker, RT_TRUE);
+            if (node != RT_NULL)
+            {
+                worker->steal_cnt++;
+            }
+        }
+
+        if (node != RT_NULL)
+        {
+            if (idle)
+            {
+                rt_atomic_and(&g_ebus_exec_.idle_mask, ~bit);
+                idle = RT_FALSE;
+            }
+            EbusExecRun(worker, node);
+        }
+        else if (!idle)
+        {
+            // 先登记空闲再检查一遍，登记前就绪在其他忙碌线程上的节点不会错过
+            rt_atomic_or(&g_ebus_exec_.idle_mask, bit);
+            idle = RT_TRUE;
+        }
+        else
+        {
+            rt_sem_take(&worker->sem, RT_WAITING_FOREVER);
+            rt_atomic_and(&g_ebus_exec_.idle_mask, ~bit);
+            idle = RT_FALSE;
+        }
+    }
+    rt_sem_release(&g_ebus_exec_.exit_sem);
+}
+
+/**
+ * @description: 查找事件属性项，不存在时追加一项，调用者需持有写锁
+ * @param {uint16_t} evt_id
+ * @return {*} 属性表满返回RT_NULL
+ */
+static sEbusEvtAttr_t *EbusEvtAttrGetLocked(uint16_t evt_id)
+{
+    int i;
+    for (i = 0; i < g_ebus_.evt_attr_num; i++)
+    {
+        if (g_ebus_.evt_attr[i].evt_id == evt_id)
+        {
+            return &g_ebus_.evt_attr[i];
+        }
+    }
+    if (i >= EBUS_EVT_ATTR_NUM)
+    {
+        LOG_E("[Ebus] Event attribute table full: evt=%x", evt_id);
+        return RT_NULL;
+    }
+
+    // 新项属性为0，先写入内容再增加数量，无锁读者不会读到未填写的项
+    g_ebus_.evt_attr[i].evt_id = evt_id;
+    g_ebus_.evt_attr[i].deadline = 0;
+    g_ebus_.evt_attr[i].ttl = 0;
+    rt_memset(&g_ebus_.evt_attr[i].rate, 0, sizeof(sEbusRate_t));
+    rt_spin_lock_init(&g_ebus_.evt_attr[i].rate.lock);
+    g_ebus_.evt_attr_num = (uint8_t)(i + 1);
+    return &g_ebus_.evt_attr[i];
+}
+
+/**
+ * @description: 设置事件的相对截止时间，未在消息中指定截止时间的该事件按此填充
+ * @param {uint16_t} evt_id
+ * @param {uint16_t} deadline 相对发送时刻的截止时间(tick)，0表示取消
+ * @return {*} 属性表满返回eEbusRst_NoMemory
+ */
+eEbusRst_t EbusEvtDeadlineSet(uint16_t evt_id, uint16_t deadline)
+{
+    if (!g_ebus_.init)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    EbusWriteLock();
+    sEbusEvtAttr_t *attr = EbusEvtAttrGetLocked(evt_id);
+    if (attr != RT_NULL)
+    {
+        attr->deadline = deadline;
+    }
+    EbusWriteUnlock();
+    return (attr != RT_NULL) ? eEbusRst_Success : eEbusRst_NoMemory;
+}
+
+/**
+ * @description: 设置事件的有效期，未在消息中指定有效期的该事件按此填充
+ * @param {uint16_t} evt_id
+ * @param {uint16_t} ttl 相对发送时刻的有效期(tick)，0表示取消
+ * @return {*} 属性表满返回eEbusRst_NoMemory
+ */
+eEbusRst_t EbusEvtTtlSet(uint16_t evt_id, uint16_t ttl)
+{
+    if (!g_ebus_.init)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    EbusWriteLock();
+    sEbusEvtAttr_t *attr = EbusEvtAttrGetLocked(evt_id);
+    if (attr != RT_NULL)
+    {
+        attr->ttl = ttl;
+    }
+    EbusWriteUnlock();
+    return (attr != RT_NULL) ? eEbusRst_Success : eEbusRst_NoMemory;
+}
+
+/**
+ * @description: 令牌桶参数设置，桶初始为满
+ * @param {sEbusRate_t} *rate
+ * @param {uint16_t} rate_num
+ * @param {uint16_t} burst
+ * @param {eEbusRatePolicy_t} policy
+ * @return {*}
+ */
+static void EbusRateSetLocked(sEbusRate_t *rate, uint16_t rate_num, uint16_t burst, eEbusRatePolicy_t policy)
+{
+    rate->rate = rate_num;
+    rate->burst = (burst != 0) ? burst : 1;
+    rate->policy = (uint8_t)policy;
+    rate->last = rt_tick_get();
+    rate->tokens = (uint32_t)rate->burst * RT_TICK_PER_SECOND;
+}
+
+/**
+ * @description: 设置事件的令牌桶，所有发送源发送该事件共用
+ * @param {uint16_t} evt_id
+ * @param {uint16_t} rate 每秒允许的消息数，0表示不限流
+ * @param {uint16_t} burst 允许的突发消息数
+ * @param {eEbusRatePolicy_t} policy 令牌不足时的策略
+ * @return {*} 属性表满返回eEbusRst_NoMemory
+ */
+eEbusRst_t EbusEvtRateSet(uint16_t evt_id, uint16_t rate, uint16_t burst, eEbusRatePolicy_t policy)
+{
+    if (!g_ebus_.init || policy > eEbusRatePolicy_Delay)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    EbusWriteLock();
+    sEbusEvtAttr_t *attr = EbusEvtAttrGetLocked(evt_id);
+    if (attr != RT_NULL)
+    {
+        rt_base_t level = rt_spin_lock_irqsave(&attr->rate.lock);
+        EbusRateSetLocked(&attr->rate, rate, burst, policy);
+        rt_spin_unlock_irqrestore(&attr->rate.lock, level);
+    }
+    EbusWriteUnlock();
+    return (attr != RT_NULL) ? eEbusRst_Success : eEbusRst_NoMemory;
+}
+
+/**
+ * @description: 设置节点作为发送源的令牌桶，限制该节点发出的广播、通知和指示
+ * @param {sEbusNode_t} *node
+ * @param {uint16_t} rate 每秒允许的消息数，0表示不限流
+ * @param {uint16_t} burst 允许的突发消息数
+ * @param {eEbusRatePolicy_t} policy 令牌不足时的策略
+ * @return {*}
+ */
+eEbusRst_t EbusNodeRateSet(sEbusNode_t *node, uint16_t rate, uint16_t burst, eEbusRatePolicy_t policy)
+{
+    if (node == RT_NULL || !node->init || policy > eEbusRatePolicy_Delay)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    rt_base_t level = rt_spin_lock_irqsave(&node->rate.lock);
+    EbusRateSetLocked(&node->rate, rate, burst, policy);
+    rt_spin_unlock_irqrestore(&node->rate.lock, level);
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 启用信用流控，节点最多接受credit个未完成的指示，请求方收到响应或超时后归还信用
+ * @param {sEbusNode_t} *node 响应方节点
+ * @param {uint16_t} credit 不超过消息队列深度，0表示关闭
+ * @return {*}
+ */
+eEbusRst_t EbusNodeCreditSet(sEbusNode_t *node, uint16_t credit)
+{
+    if (node == RT_NULL || !node->init || credit > node->msg_queue->max_msgs)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    // 调整上限时保持已借出的数量
+    EbusWriteLock();
+    rt_atomic_t lent = node->credit_max ? (rt_atomic_t)node->credit_max - rt_atomic_load(&node->credit) : 0;
+    node->credit_max = credit;
+    rt_atomic_store(&node->credit, (rt_atomic_t)credit - lent);
+    EbusWriteUnlock();
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 查询目标节点剩余信用，发送方据此控制并发的指示数量
+ * @param {uint32_t} dst_node_id 目标节点名称ID EBUS_NODE_ID("name")
+ * @return {*} 目标未启用信用流控返回-1，节点不存在返回0
+ */
+int EbusCreditAvail(uint32_t dst_node_id)
+{
+    int avail = 0;
+
+    EbusReadLock();
+    sEbusNode_t *target_node = EbusFindNodeByHashLocked(dst_node_id, RT_NULL);
+    if (target_node != RT_NULL)
+    {
+        avail = target_node->credit_max ? (int)rt_atomic_load(&target_node->credit) : -1;
+    }
+    EbusReadUnlock();
+    return avail;
+}
+
+/**
+ * @description: 添加内容过滤条件，同一事件的多个条件须全部满足，其他事件不受影响
+ * @param {sEbusNode_t} *node 接收方节点
+ * @param {uint16_t} evt_id 事件id
+ * @param {uint8_t} offset 比较的起始字节
+ * @param {uint8_t} len 比较的字节数 1~4，按小端拼成整数
+ * @param {uint32_t} mask 掩码
+ * @param {uint32_t} value 期望值，(值 & mask) == value 时通过
+ * @return {*} 条件已满返回eEbusRst_NoMemory
+ */
+eEbusRst_t EbusNodeFilterAdd(sEbusNode_t *node, uint16_t evt_id, uint8_t offset, uint8_t len, uint32_t mask,
+                             uint32_t value)
+{
+    if (node == RT_NULL || !node->init || len == 0 || len > sizeof(uint32_t) || offset + len > node->msg_size ||
+        (value & ~mask) != 0)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    eEbusRst_t rst = eEbusRst_NoMemory;
+    EbusWriteLock();
+    if (node->filter_num < EBUS_NODE_FILTER_NUM)
+    {
+        sEbusFilter_t *filter = &node->filter[node->filter_num];
+        filter->evt_id = evt_id;
+        filter->offset = offset;
+        filter->len = len;
+        filter->mask = mask;
+        filter->value = value;
+        node->filter_num++;
+        rst = eEbusRst_Success;
+    }
+    EbusWriteUnlock();
+    return rst;
+}
+
+/**
+ * @description: 删除某个事件的全部内容过滤条件
+ * @param {sEbusNode_t} *node 接收方节点
+ * @param {uint16_t} evt_id 事件id
+ * @return {*} 该事件没有过滤条件返回eEbusRst_NodeNotFound
+ */
+eEbusRst_t EbusNodeFilterClear(sEbusNode_t *node, uint16_t evt_id)
+{
+    if (node == RT_NULL || !node->init)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    eEbusRst_t rst = eEbusRst_NodeNotFound;
+    EbusWriteLock();
+    for (int i = 0; i < node->filter_num;)
+    {
+        if (node->filter[i].evt_id == evt_id)
+        {
+            node->filter[i] = node->filter[--node->filter_num];
+            rst = eEbusRst_Success;
+        }
+        else
+        {
+            i++;
+        }
+    }
+    EbusWriteUnlock();
+    return rst;
+}
+
+/**
+ * @description: 设置自定义过滤函数，在内容过滤条件之后检查，返回RT_FALSE的消息不入队
+ * @param {sEbusNode_t} *node 接收方节点
+ * @param {EbusFilterPtr} filter_fn 在发送端上下文调用(可能是中断)，须短小且不阻塞，RT_NULL表示关闭
+ * @param {void} *user_data
+ * @return {*}
+ */
+void EbusNodeFilterSet(sEbusNode_t *node, EbusFilterPtr filter_fn, void *user_data)
+{
+    if (node == RT_NULL || !node->init)
+    {
+        return;
+    }
+
+    EbusWriteLock();
+    node->filter_fn = filter_fn;
+    node->filter_arg = user_data;
+    EbusWriteUnlock();
+}
+
+/**
+ * @description: 设置传输端口，发给该节点的消息(持有注册表读锁时)交给端口转发到总线外，端口须不阻塞
+ * @param {sEbusNode_t} *node 代表总线外节点的本地节点
+ * @param {EbusPortPtr} port 返回-RT_EFULL计入队列满，RT_NULL表示恢复入队
+ * @param {void} *port_arg
+ * @return {*}
+ */
+void EbusNodeSetPort(sEbusNode_t *node, EbusPortPtr port, void *port_arg)
+{
+    if (node == RT_NULL || !node->init)
+    {
+        return;
+    }
+
+    EbusWriteLock();
+    node->port = port;
+    node->port_arg = port_arg;
+    EbusWriteUnlock();
+}
+
+/**
+ * @description: 传输端口把总线外收到的消息注入本地节点，保留消息类型、事件id、截止时间和有效期
+ * @param {sEbusNode_t} *node 作为消息源的本地端口节点
+ * @param {uint32_t} dst_node_id 目标节点名称ID，0表示发给除端口节点外的所有节点
+ * @param {sEbusMsgItem_t} *msg 广播、组播或通知
+ * @return {*}
+ */
+eEbusRst_t EbusPortInject(sEbusNode_t *node, uint32_t dst_node_id, sEbusMsgItem_t *msg)
+{
+    if (node == RT_NULL || !node->init || msg == RT_NULL ||
+        (msg->type != eEbusMsgType_Broadcast && msg->type != eEbusMsgType_Multicast &&
+         msg->type != eEbusMsgType_Notification))
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    msg->flag = EBUS_MSG_FLAG_REMOTE;
+    msg->src_node_idx = node->node_idx;
+    msg->seq_num = EbusGetSn(node);
+    msg->timestamp = rt_tick_get();
+
+    eEbusRst_t rst = eEbusRst_Success;
+    EbusReadLock();
+    if (dst_node_id == 0)
+    {
+        msg->dst_node_idx = EBUS_NODE_IDX_BROADCAST;
+        EbusMsgRouteLocked(msg);
+    }
+    else
+    {
+        // 按原消息类型只投递给指定节点，端口已在总线外完成扇出
+        sEbusNode_t *target_node = EbusFindNodeByHashLocked(dst_node_id, RT_NULL);
+        if (target_node == RT_NULL)
+        {
+            rst = eEbusRst_NodeNotFound;
+        }
+        else
+        {
+            msg->dst_node_idx = target_node->node_idx;
+            rt_err_t result = EbusMsgPut(target_node, msg);
+            if (result != RT_EOK)
+            {
+                rst = (result == -RT_EFULL) ? eEbusRst_QueueFull : eEbusRst_ParamErr;
+            }
+        }
+    }
+    EbusReadUnlock();
+    return rst;
+}
+
+/**
+ * @description: 创建节点回调执行器，SMP下工作线程依次绑定到各CPU
+ * @param {uint8_t} worker_num 工作线程数量，不超过EBUS_EXEC_MAX_WORKER
+ * @return {*}
+ */
+eEbusRst_t EbusExecCreate(uint8_t worker_num)
+{
+    if (worker_num == 0 || worker_num > EBUS_EXEC_MAX_WORKER)
+    {
+        LOG_E("[Ebus] Invalid executor worker number: %d", worker_num);
+        return eEbusRst_ParamErr;
+    }
+    if (g_ebus_exec_.init)
+    {
+        LOG_W("[Ebus] Executor already created");
+        return eEbusRst_Success;
+    }
+
+    rt_memset(&g_ebus_exec_, 0, sizeof(g_ebus_exec_));
+    rt_sem_init(&g_ebus_exec_.exit_sem, "ebusexit", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&g_ebus_exec_.detach_sem, "ebusdet", 0, RT_IPC_FLAG_FIFO);
+    g_ebus_exec_.worker_num = worker_num;
+    rt_atomic_store(&g_ebus_exec_.running, 1);
+
+    for (int i = 0; i < worker_num; i++)
+    {
+        sEbusExecWorker_t *worker = &g_ebus_exec_.worker[i];
+        char name[RT_NAME_MAX];
+
+        rt_spin_lock_init(&worker->lock);
+        worker->id = i;
+        worker->cpu = (uint8_t)(i % EBUS_CPU_NUM);
+        rt_snprintf(name, sizeof(name), "ebusw%d", i);
+        worker->thread = rt_thread_create(name, EbusExecWorkerEntry, worker,
+                                          EBUS_EXEC_THREAD_STACK_SIZE, EBUS_EXEC_THREAD_PRIORITY, 5);
+        if (worker->thread == RT_NULL)
+        {
+            LOG_E("[Ebus] Failed to create executor worker %d", i);
+            // 已创建的工作线程尚未启动，直接删除，不能经EbusExecDestory等待其退出
+            for (int j = 0; j < i; j++)
+            {
+                rt_thread_delete(g_ebus_exec_.worker[j].thread);
+                rt_sem_detach(&g_ebus_exec_.worker[j].sem);
+            }
+            rt_sem_detach(&g_ebus_exec_.exit_sem);
+            rt_sem_detach(&g_ebus_exec_.detach_sem);
+            rt_memset(&g_ebus_exec_, 0, sizeof(g_ebus_exec_));
+            return eEbusRst_NoMemory;
+        }
+        rt_sem_init(&worker->sem, name, 0, RT_IPC_FLAG_FIFO);
+#ifdef RT_USING_SMP
+        rt_thread_control(worker->thread, RT_THREAD_CTRL_BIND_CPU, (void *)(rt_ubase_t)worker->cpu);
+#endif
+    }
+    for (int i = 0; i < worker_num; i++)
+    {
+        rt_thread_startup(g_ebus_exec_.worker[i].thread);
+    }
+
+    g_ebus_exec_.init = 1;
+    LOG_D("[Ebus] Executor created: workers=%d", worker_num);
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 销毁执行器，等待工作线程退出并解除所有节点
+ * @return {*}
+ */
+void EbusExecDestory(void)
+{
+    if (!g_ebus_exec_.init)
+    {
+        return;
+    }
+
+    rt_atomic_store(&g_ebus_exec_.running, 0);
+    for (int i = 0; i < g_ebus_exec_.worker_num; i++)
+    {
+        rt_sem_release(&g_ebus_exec_.worker[i].sem);
+    }
+    for (int i = 0; i < g_ebus_exec_.worker_num; i++)
+    {
+        if (g_ebus_exec_.worker[i].thread != RT_NULL)
+        {
+            rt_sem_take(&g_ebus_exec_.exit_sem, RT_WAITING_FOREVER);
+        }
+    }
+
+    // 工作线程已退出，剩余的就绪节点直接解除
+    for (int i = 0; i < g_ebus_exec_.worker_num; i++)
+    {
+        sEbusExecWorker_t *worker = &g_ebus_exec_.worker[i];
+        while (worker->head != RT_NULL)
+        {
+            sEbusNode_t *node = worker->head;
+            EbusExecUnlinkLocked(worker, node);
+            rt_atomic_store(&node->exec_state, EBUS_EXEC_STATE_IDLE);
+        }
+        rt_sem_detach(&worker->sem);
+    }
+    EbusExecDetachWake();
+    if (g_ebus_.init)
+    {
+        EbusReadLock();
+        for (int i = 0; i < g_ebus_.slot_cap; i++)
+        {
+            if (g_ebus_.node_tbl[i] != RT_NULL)
+            {
+                g_ebus_.node_tbl[i]->exec_attached = 0;
+            }
+        }
+        EbusReadUnlock();
+    }
+
+    rt_sem_detach(&g_ebus_exec_.exit_sem);
+    rt_sem_detach(&g_ebus_exec_.detach_sem);
+    g_ebus_exec_.init = 0;
+    LOG_D("[Ebus] Executor destroyed");
+}
+
+/**
+ * @description: 节点交由执行器执行回调，之后不能再由其他线程接收该节点的消息
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+eEbusRst_t EbusExecAttach(sEbusNode_t *node)
+{
+    if (node == RT_NULL || !node->init || node->Evtcb == RT_NULL || !g_ebus_exec_.init)
+    {
+        LOG_E("[Ebus] Invalid parameters for executor attach");
+        return eEbusRst_ParamErr;
+    }
+    if (node->exec_attached)
+    {
+        return eEbusRst_Success;
+    }
+
+    node->exec_worker = EbusExecPickWorker(node);
+    rt_atomic_store(&node->exec_state, EBUS_EXEC_STATE_IDLE);
+    node->exec_attached = 1;
+
+    // 挂接前已入队的消息
+    node->exec_urgent = 0;
+    if (node->msg_queue->entry != 0)
+    {
+        EbusExecSchedule(node, RT_FALSE);
+    }
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 查找正在执行节点的工作线程
+ * @param {sEbusNode_t} *node
+ * @return {*} 没有工作线程在执行该节点时返回RT_NULL
+ */
+static sEbusExecWorker_t *EbusExecRunner(sEbusNode_t *node)
+{
+    for (int i = 0; i < g_ebus_exec_.worker_num; i++)
+    {
+        if (rt_atomic_load(&g_ebus_exec_.worker[i].current) == (rt_atomic_t)node)
+        {
+            return &g_ebus_exec_.worker[i];
+        }
+    }
+    return RT_NULL;
+}
+
+/**
+ * @description: 节点是否正在当前线程上由执行器执行，即调用者位于该节点自身的回调中
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+static rt_bool_t EbusExecInSelf(sEbusNode_t *node)
+{
+    if (!g_ebus_exec_.init)
+    {
+        return RT_FALSE;
+    }
+    sEbusExecWorker_t *worker = EbusExecRunner(node);
+    return worker != RT_NULL && worker->thread == rt_thread_self();
+}
+
+/**
+ * @description: 节点退出执行器，正在执行时等待本批消息执行完；在该节点自身回调中调用时本批结束后生效，不等待
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+void EbusExecDetach(sEbusNode_t *node)
+{
+    if (node == RT_NULL || !node->exec_attached)
+    {
+        return;
+    }
+
+    node->exec_attached = 0;
+    if (EbusExecInSelf(node))
+    {
+        return;
+    }
+    // 节点回到空闲后工作线程仍可能在检查队列，等它离开节点
+    while (rt_atomic_load(&node->exec_state) != EBUS_EXEC_STATE_IDLE || EbusExecRunner(node) != RT_NULL)
+    {
+        sEbusExecWorker_t *worker = &g_ebus_exec_.worker[node->exec_worker % g_ebus_exec_.worker_num];
+        rt_base_t level = rt_spin_lock_irqsave(&worker->lock);
+        if (node->exec_linked != EBUS_EXEC_LINK_NONE && node->exec_worker == worker->id)
+        {
+            EbusExecUnlinkLocked(worker, node);
+            rt_atomic_store(&node->exec_state, EBUS_EXEC_STATE_IDLE);
+        }
+        rt_spin_unlock_irqrestore(&worker->lock, level);
+
+        // 先登记再检查，工作线程离开节点或调度放弃入队后必然看到登记
+        rt_atomic_add(&g_ebus_exec_.detach_wait, 1);
+        if (rt_atomic_load(&node->exec_state) != EBUS_EXEC_STATE_IDLE || EbusExecRunner(node) != RT_NULL)
+        {
+            rt_sem_take(&g_ebus_exec_.detach_sem, RT_WAITING_FOREVER);
+        }
+    }
+}
+
+#if EBUS_DEDUP_ENABLE
+/**
+ * @description: 查找请求方的重复抑制窗口，调用者需持有resp_mutex
+ * @param {sEbusNode_t} *node 接收方
+ * @param {uint16_t} src_node_idx 请求方句柄
+ * @param {rt_bool_t} alloc 不存在时是否分配，请求方槽位用尽时替换最久未用的请求方
+ * @return {*} 不分配且不存在时返回RT_NULL
+ */
+static sEbusDedupSrc_t *EbusDedupSrcLocked(sEbusNode_t *node, uint16_t src_node_idx, rt_bool_t alloc)
+{
+    sEbusDedupSrc_t *victim = RT_NULL;
+    int victim_rank = 0;
+
+    for (int i = 0; i < EBUS_DEDUP_SRC_NUM; i++)
+    {
+        sEbusDedupSrc_t *src = &node->dedup[i];
+        if (src->used && src->src_node_idx == src_node_idx)
+        {
+            return src;
+        }
+
+        // 替换顺序：空闲槽位，没有处理中指示的请求方，其余请求方；同级中替换最久未用的
+        int rank = 3;
+        if (src->used)
+        {
+            rank = 2;
+            for (int j = 0; j < EBUS_DEDUP_WINDOW; j++)
+            {
+                if (src->entry[j].state == eEbusMsgState_Sented)
+                {
+                    rank = 1;
+                    break;
+                }
+            }
+        }
+        if (victim == RT_NULL || rank > victim_rank ||
+            (rank == victim_rank && EBUS_DEADLINE_BEFORE(src->last, victim->last)))
+        {
+            victim = src;
+            victim_rank = rank;
+        }
+    }
+    if (!alloc)
+    {
+        return RT_NULL;
+    }
+
+    rt_memset(victim, 0, sizeof(sEbusDedupSrc_t));
+    victim->used = 1;
+    victim->src_node_idx = src_node_idx;
+    return victim;
+}
+
+/**
+ * @description: 检查可重传指示是否重复，新指示记入重复抑制窗口
+ * @param {sEbusNode_t} *node 接收方
+ * @param {sEbusMsgItem_t} *msg 可重传指示
+ * @param {sEbusMsgItem_t} *resp 重复且已响应时填写待重发的响应
+ * @param {rt_bool_t} *replay 输出是否需要重发响应
+ * @return {*} 重复返回RT_TRUE
+ */
+static rt_bool_t EbusDedupCheck(sEbusNode_t *node, const sEbusMsgItem_t *msg, sEbusMsgItem_t *resp,
+                                rt_bool_t *replay)
+{
+    rt_bool_t dup = RT_FALSE;
+
+    *replay = RT_FALSE;
+    rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
+    sEbusDedupSrc_t *src = EbusDedupSrcLocked(node, msg->src_node_idx, RT_TRUE);
+    src->last = rt_tick_get();
+    for (int i = 0; i < EBUS_DEDUP_WINDOW; i++)
+    {
+        sEbusDedup_t *dedup = &src->entry[i];
+        if (dedup->state != eEbusMsgState_Idle && dedup->seq_num == msg->seq_num)
+        {
+            dup = RT_TRUE;
+            if (dedup->state == eEbusMsgState_Recved)
+            {
+                rt_memset(resp, 0, EBUS_MSG_HEAD_SIZE);
+                resp->type = eEbusMsgType_Response;
+                resp->flag = EBUS_MSG_FLAG_RETRY;
+                resp->src_node_idx = node->node_idx;
+                resp->dst_node_idx = msg->src_node_idx;
+                resp->seq_num = msg->seq_num;
+                resp->evt_id = dedup->evt_id;
+                resp->timestamp = rt_tick_get();
+                resp->len = dedup->len;
+                rt_memcpy(resp->data, dedup->data, dedup->len);
+                *replay = RT_TRUE;
+            }
+            break;
+        }
+    }
+    if (!dup)
+    {
+        // 窗口满时覆盖最早的已响应记录，处理中的记录只有在全部处理中时才被覆盖
+        int pos = src->pos;
+        for (int i = 0; i < EBUS_DEDUP_WINDOW && src->entry[pos].state == eEbusMsgState_Sented; i++)
+        {
+            pos = (pos + 1) % EBUS_DEDUP_WINDOW;
+        }
+        if (src->entry[pos].state == eEbusMsgState_Sented)
+        {
+            pos = src->pos;
+        }
+        src->pos = (uint8_t)((pos + 1) % EBUS_DEDUP_WINDOW);
+        sEbusDedup_t *dedup = &src->entry[pos];
+        dedup->seq_num = msg->seq_num;
+        dedup->state = eEbusMsgState_Sented;
+    }
+    rt_mutex_release(node->resp_mutex);
+    return dup;
+}
+#endif
+
+/**
+ * @description: 广播、组播、通知消息是否已超过有效期，指示和响应不过期以免等待项无人释放
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+static rt_bool_t EbusMsgExpired(const sEbusMsgItem_t *msg)
+{
+    if (msg->ttl == 0 || msg->type == eEbusMsgType_Indication || msg->type == eEbusMsgType_Response)
+    {
+        return RT_FALSE;
+    }
+    return (rt_tick_get() - msg->timestamp > msg->ttl) ? RT_TRUE : RT_FALSE;
+}
+
+/**
+ * @description: 接收
+ * @param {sEbusNode_t} *node
+ * @param {sEbusMsgItem_t} *msg
+ * @param {uint32_t} timeout
+ * @return {*}
+ */
+eEbusRst_t EbusMsgWaitRecv(sEbusNode_t *node, sEbusMsgItem_t *msg, uint32_t timeout)
+{
+    if (node == RT_NULL || !node->init || msg == RT_NULL)
+    {
+        LOG_E("[Ebus] Invalid parameters for message receive");
+        return eEbusRst_ParamErr;
+    }
+
+    LOG_D("[Ebus] Waiting for message: node=%s, timeout=%d", node->name, timeout);
+
+    // 再次接收说明上一条消息已处理完
+    node->recv_busy = 0;
+    rt_tick_t start = rt_tick_get();
+    rt_ssize_t len = rt_mq_recv(node->msg_queue, msg, sizeof(sEbusMsgItem_t), timeout);
+    while (len > 0 && EbusMsgExpired(msg))
+    {
+        // 积压后连续丢弃过期消息，不经过回调，之后在剩余等待时间内接收
+        node->stat.expired_cnt++;
+        rt_tick_t elapsed = rt_tick_get() - start;
+        uint32_t wait = timeout;
+        if (timeout != (uint32_t)RT_WAITING_FOREVER)
+        {
+            wait = (elapsed < timeout) ? timeout - elapsed : 0;
+        }
+        len = rt_mq_recv(node->msg_queue, msg, sizeof(sEbusMsgItem_t), wait);
+    }
+    if (len > 0)
+    {
+        node->recv_busy = 1;
+        if (msg->deadline != 0 && rt_tick_get() - msg->timestamp > msg->deadline)
+        {
+            node->stat.deadline_miss_cnt++;
+        }
+        LOG_D("[Ebus] Message received: node=%s, type=%d, seq=%d, src=%d, dst=%d",
+              node->name, msg->type, msg->seq_num, msg->src_node_idx, msg->dst_node_idx);
+
+        if (msg->type == eEbusMsgType_Indication && node->Evtcb != RT_NULL)
+        {
+            LOG_D("[Ebus] Processing indication: seq=%d, src=%d, dst=%d",
+                  msg->seq_num, msg->src_node_idx, msg->dst_node_idx);
+#if EBUS_DEDUP_ENABLE
+            sEbusMsgItem_t resp;
+            rt_bool_t replay;
+            if ((msg->flag & EBUS_MSG_FLAG_RETRY) && EbusDedupCheck(node, msg, &resp, &replay))
+            {
+                // 重传的指示不再调用回调，已响应时重发响应
+                node->stat.dup_cnt++;
+                if (replay)
+                {
+                    EbusMsgSend(node, &resp);
+                }
+                return eEbusRst_OtherEvt;
+            }
+#endif
+            sEbusNode_t *ack_node = (sEbusNode_t *)EbusFindNodeByIdx(msg->src_node_idx);
+            if (ack_node != RT_NULL)
+            {
+                node->Evtcb(eEBusEvtType_IndicationCb, node, msg, ack_node);
+                LOG_D("[Ebus] Indication callback invoked");
+            }
+            else
+            {
+                LOG_W("[Ebus] Source node not found for indication: idx=%d", msg->src_node_idx);
+            }
+            return eEbusRst_OtherEvt;
+        }
+        else if (msg->type == eEbusMsgType_Response && node->Evtcb != RT_NULL)
+        {
+            LOG_D("[Ebus] Processing response: seq=%d, src=%d, dst=%d",
+                  msg->seq_num, msg->src_node_idx, msg->dst_node_idx);
+            if ((msg->flag & EBUS_MSG_FLAG_RETRY) &&
+                EbusFindWaitRespItem(node, msg->seq_num, msg->src_node_idx) < 0)
+            {
+                // 可重传指示的重复响应，等待项已由先到的响应释放
+                node->stat.dup_cnt++;
+                return eEbusRst_OtherEvt;
+            }
+            int gather_no = EbusFindWaitRespGather(node, msg->seq_num, msg->src_node_idx);
+            if (gather_no >= 0)
+            {
+                // 汇聚指示的响应先暂存，全部到达或超时时一次交付
+                EbusGatherCollect(node, gather_no, msg);
+                return eEbusRst_OtherEvt;
+            }
+            node->Evtcb(eEBusEvtType_IndicationAckCb, node, msg,
+                        EbusFindWaitRespCtx(node, msg->seq_num, msg->src_node_idx));
+            EbusProcessResponse(node, msg);
+            return eEbusRst_OtherEvt;
+        }
+        return eEbusRst_Success;
+    }
+    else if (len == -RT_ETIMEOUT)
+    {
+        LOG_D("[Ebus] Message receive timeout: node=%s", node->name);
+        return eEbusRst_Timeout;
+    }
+    else
+    {
+        LOG_E("[Ebus] Message receive failed: node=%s, err=%d", node->name, len);
+        return eEbusRst_Fail;
+    }
+}
+
+/**
+ * @description: 接收
+ * @param {sEbusNode_t} *node
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+eEbusRst_t EbusMsgRecv(sEbusNode_t *node, sEbusMsgItem_t *msg)
+{
+    LOG_D("[Ebus] Try receive message: node=%s", node->name);
+    return EbusMsgWaitRecv(node, msg, 0);
+}
+
+/**
+ * @description: 消息广播
+ * @param {sEbusNode_t} *node
+ * @param {char} dst_node_name
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+eEbusRst_t EbusBroadcast(sEbusNode_t *node, sEbusMsgItem_t *msg)
+{
+    if (node == RT_NULL || !node->init || msg == RT_NULL)
+    {
+        LOG_E("[Ebus] Invalid parameters for broadcast");
+        return eEbusRst_ParamErr;
+    }
+
+    LOG_D("[Ebus] Broadcasting: from node=%s, evt=%x", node->name, msg->evt_id);
+
+    msg->type = eEbusMsgType_Broadcast;
+    msg->flag = 0;
+    msg->src_node_idx = node->node_idx;
+    msg->dst_node_idx = EBUS_NODE_IDX_BROADCAST;
+    msg->seq_num = EbusGetSn(node);
+    msg->timestamp = rt_tick_get();
+
+    return EbusMsgSend(node, msg);
+}
+
+/**
+ * @description: 创建组播组
+ * @param {char} *name 组名称，组名称ID为EBUS_NODE_ID(name)
+ * @return {*} 组表满返回eEbusRst_NoMemory，同名组已存在返回eEbusRst_NameCollision
+ */
+eEbusRst_t EbusGroupCreate(const char *name)
+{
+    if (!g_ebus_.init || name == RT_NULL)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    uint32_t group_id = EbusNameHash(name);
+    eEbusRst_t rst = eEbusRst_NoMemory;
+    EbusWriteLock();
+    if (EbusGroupFindLocked(group_id) >= 0)
+    {
+        rst = eEbusRst_NameCollision;
+    }
+    else
+    {
+        for (int i = 0; i < EBUS_GROUP_NUM; i++)
+        {
+            if (!g_ebus_.group[i].used)
+            {
+                g_ebus_.group[i].used = 1;
+                g_ebus_.group[i].group_id = group_id;
+                g_ebus_.group[i].member_num = 0;
+                rst = eEbusRst_Success;
+                break;
+            }
+        }
+    }
+    EbusWriteUnlock();
+
+    if (rst != eEbusRst_Success)
+    {
+        LOG_E("[Ebus] Create group %s failed: %d", name, rst);
+    }
+    return rst;
+}
+
+/**
+ * @description: 删除组播组
+ * @param {uint32_t} group_id 组名称ID EBUS_NODE_ID("name")
+ * @return {*}
+ */
+eEbusRst_t EbusGroupDestory(uint32_t group_id)
+{
+    if (!g_ebus_.init)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    EbusWriteLock();
+    int idx = EbusGroupFindLocked(group_id);
+    if (idx >= 0)
+    {
+        // 保留并递增代次，已解析出旧句柄的组播不会投递到复用此表项的新组
+        uint8_t gen = g_ebus_.group[idx].gen + 1;
+        rt_memset(&g_ebus_.group[idx], 0, sizeof(sEbusGroup_t));
+        g_ebus_.group[idx].gen = gen;
+    }
+    EbusWriteUnlock();
+    return (idx >= 0) ? eEbusRst_Success : eEbusRst_NodeNotFound;
+}
+
+/**
+ * @description: 节点加入组播组，已是成员时直接返回成功
+ * @param {sEbusNode_t} *node
+ * @param {uint32_t} group_id 组名称ID EBUS_NODE_ID("name")
+ * @return {*} 组成员已满返回eEbusRst_NoMemory
+ */
+eEbusRst_t EbusGroupJoin(sEbusNode_t *node, uint32_t group_id)
+{
+    if (node == RT_NULL || !node->init)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    eEbusRst_t rst = eEbusRst_NodeNotFound;
+    EbusWriteLock();
+    int idx = EbusGroupFindLocked(group_id);
+    if (idx >= 0)
+    {
+        sEbusGroup_t *group = &g_ebus_.group[idx];
+        rst = eEbusRst_Success;
+        for (int m = 0; m < group->member_num; m++)
+        {
+            if (group->member[m] == node->node_idx)
+            {
+                idx = -1;
+                break;
+            }
+        }
+        if (idx >= 0)
+        {
+            if (group->member_num < EBUS_GROUP_MAX_MEMBER)
+            {
+                group->member[group->member_num++] = node->node_idx;
+            }
+            else
+            {
+                rst = eEbusRst_NoMemory;
+            }
+        }
+    }
+    EbusWriteUnlock();
+    return rst;
+}
+
+/**
+ * @description: 节点退出组播组
+ * @param {sEbusNode_t} *node
+ * @param {uint32_t} group_id 组名称ID EBUS_NODE_ID("name")
+ * @return {*}
+ */
+eEbusRst_t EbusGroupLeave(sEbusNode_t *node, uint32_t group_id)
+{
+    if (node == RT_NULL || !node->init)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    eEbusRst_t rst = eEbusRst_NodeNotFound;
+    EbusWriteLock();
+    int idx = EbusGroupFindLocked(group_id);
+    if (idx >= 0)
+    {
+        sEbusGroup_t *group = &g_ebus_.group[idx];
+        for (int m = 0; m < group->member_num; m++)
+        {
+            if (group->member[m] == node->node_idx)
+            {
+                group->member[m] = group->member[--group->member_num];
+                rst = eEbusRst_Success;
+                break;
+            }
+        }
+    }
+    EbusWriteUnlock();
+    return rst;
+}
+
+/**
+ * @description: 组播，一次分配序列号并在一次遍历中投递到所有成员（除了自己）
+ * @param {sEbusNode_t} *node
+ * @param {uint32_t} group_id 组名称ID EBUS_NODE_ID("name")
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+eEbusRst_t EbusMulticast(sEbusNode_t *node, uint32_t group_id, sEbusMsgItem_t *msg)
+{
+    if (node == RT_NULL || !node->init || msg == RT_NULL)
+    {
+        LOG_E("[Ebus] Invalid parameters for multicast");
+        return eEbusRst_ParamErr;
+    }
+
+    // 解析出带代次的组句柄，投递时在读锁内核对，期间组被删除或表项被复用则不投递
+    EbusReadLock();
+    int idx = EbusGroupFindLocked(group_id);
+    uint16_t group_idx = (idx >= 0) ? EBUS_GROUP_IDX_MAKE(idx, g_ebus_.group[idx].gen) : 0;
+    EbusReadUnlock();
+    if (idx < 0)
+    {
+        LOG_E("[Ebus] Multicast group not found: id=0x%08X", group_id);
+        return eEbusRst_NodeNotFound;
+    }
+
+    msg->type = eEbusMsgType_Multicast;
+    msg->flag = 0;
+    msg->src_node_idx = node->node_idx;
+    msg->dst_node_idx = group_idx;
+    msg->seq_num = EbusGetSn(node);
+    msg->timestamp = rt_tick_get();
+
+    return EbusMsgSend(node, msg);
+}
+
+/**
+ * @description: 向已解析的目标句柄发送通知
+ * @param {sEbusNode_t} *node
+ * @param {uint16_t} dst_node_idx
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+static eEbusRst_t EbusNotificationTo(sEbusNode_t *node, uint16_t dst_node_idx, sEbusMsgItem_t *msg)
+{
+    msg->type = eEbusMsgType_Notification;
+    msg->flag = 0;
+    msg->src_node_idx = node->node_idx;
+    msg->dst_node_idx = dst_node_idx;
+    msg->seq_num = EbusGetSn(node);
+    msg->timestamp = rt_tick_get();
+
+    return EbusMsgSend(node, msg);
+}
+
+/**
+ * @description: 向已解析的目标句柄发送指示并登记等待响应项
+ * @param {sEbusNode_t} *node
+ * @param {uint16_t} dst_node_idx
+ * @param {sEbusMsgItem_t} *msg
+ * @param {void} *ctx 发送者上下文
+ * @param {rt_tick_t} timeout 应答超时时长，0表示不超时
+ * @param {uint8_t} retry_num 超时重传次数，0表示不重传
+ * @return {*}
+ */
+static eEbusRst_t EbusIndicationTo(sEbusNode_t *node, uint16_t dst_node_idx, sEbusMsgItem_t *msg,
+                                   void *ctx, rt_tick_t timeout, uint8_t retry_num)
+{
+    // 先取目标的信用，目标已满时不占用等待项
+    uint8_t credit;
+    if (!EbusCreditTake(dst_node_idx, &credit))
+    {
+        LOG_D("[Ebus] No credit for indication: node=%s, dst=0x%04X", node->name, dst_node_idx);
+        return eEbusRst_NoCredit;
+    }
+
+    // 分配等待响应项
+    int wait_idx = EbusAllocWaitRespItem(node);
+    if (wait_idx < 0)
+    {
+        LOG_E("[Ebus] No space for wait response: node=%s", node->name);
+        EbusCreditGive(credit ? dst_node_idx : EBUS_NODE_IDX_BROADCAST);
+        return eEbusRst_NoMemory;
+    }
+
+    // 可重传指示保存一份原始消息
+    sEbusRetry_t *retry = RT_NULL;
+    int retry_no;
+    if (retry_num != 0)
+    {
+        rt_base_t level = rt_spin_lock_irqsave(&g_ebus_.retry_lock);
+        for (retry_no = 0; retry_no < EBUS_RETRY_NUM; retry_no++)
+        {
+            if (!g_ebus_.retry[retry_no].used)
+            {
+                retry = &g_ebus_.retry[retry_no];
+                retry->used = 1;
+                break;
+            }
+        }
+        rt_spin_unlock_irqrestore(&g_ebus_.retry_lock, level);
+        if (retry == RT_NULL)
+        {
+            LOG_E("[Ebus] No space for retry: node=%s", node->name);
+            EbusFreeWaitRespItem(node, wait_idx);
+            return eEbusRst_NoMemory;
+        }
+    }
+
+    // 设置消息参数
+    msg->type = eEbusMsgType_Indication;
+    msg->flag = (retry != RT_NULL) ? EBUS_MSG_FLAG_RETRY : 0;
+    msg->src_node_idx = node->node_idx;
+    msg->dst_node_idx = dst_node_idx;
+    msg->seq_num = EbusGetSn(node);
+    msg->timestamp = rt_tick_get();
+
+    LOG_D("[Ebus] Async indication configured: seq=%d, wait_idx=%d", msg->seq_num, wait_idx);
+
+    // 配置等待项
+    rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
+    sEbusWaitResp_t *wait_item = &node->wait_resp_list[wait_idx];
+    wait_item->seq_num = msg->seq_num;
+    wait_item->src_node_idx = node->node_idx;
+    wait_item->dst_node_idx = dst_node_idx;
+    wait_item->send_time = rt_tick_get();
+    wait_item->timeout = timeout;
+    wait_item->ctx = ctx;
+    wait_item->credit = credit;
+    wait_item->state = eEbusMsgState_Sented;
+    if (retry != RT_NULL)
+    {
+        retry->retry_left = retry_num;
+        retry->msg = *msg;
+        wait_item->retry = (uint8_t)(retry_no + 1);
+    }
+    if (timeout != 0)
+    {
+        rt_tick_t deadline = wait_item->send_time + timeout;
+        if (node->wait_resp_timed++ == 0 || (rt_int32_t)(deadline - node->resp_deadline) < 0)
+        {
+            node->resp_deadline = deadline;
+        }
+    }
+    rt_mutex_release(node->resp_mutex);
+
+    // 发送消息
+    eEbusRst_t send_result = EbusMsgSend(node, msg);
+    if (retry != RT_NULL && (send_result == eEbusRst_QueueFull || send_result == eEbusRst_RateLimited))
+    {
+        // 目标暂时繁忙，保留等待项，超时后按退避间隔重传
+        LOG_D("[Ebus] Reliable indication deferred: seq=%d, result=%d", msg->seq_num, send_result);
+        send_result = eEbusRst_Success;
+    }
+    else if (send_result != eEbusRst_Success)
+    {
+        LOG_E("[Ebus] Async indication send failed: result=%d", send_result);
+        EbusFreeWaitRespItem(node, wait_idx);
+    }
+    else
+    {
+        LOG_D("[Ebus] Async indication sent: seq=%d, from=%s to 0x%04X",
+              msg->seq_num, node->name, dst_node_idx);
+    }
+
+    return send_result;
+}
+
+/**
+ * @description: 消息通知无应答
+ * @param {sEbusNode_t} *node
+ * @param {char} dst_node_name
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+eEbusRst_t EbusNotification(sEbusNode_t *node, char *dst_node_name, sEbusMsgItem_t *msg)
+{
+    if (node == RT_NULL || msg == RT_NULL || dst_node_name == RT_NULL)
+    {
+        LOG_E("[Ebus] Invalid parameters for notification");
+        return eEbusRst_ParamErr;
+    }
+
+    LOG_D("[Ebus] Sending notification: from=%s, to=%s, evt=%x",
+          node->name, dst_node_name, msg->evt_id);
+
+    uint16_t dst_node_idx = EbusResolveNode(EbusNameHash(dst_node_name), dst_node_name);
+    if (dst_node_idx == EBUS_NODE_IDX_BROADCAST)
+    {
+        LOG_E("[Ebus] Target node not found for notification: %s", dst_node_name);
+        return eEbusRst_NodeNotFound;
+    }
+
+    return EbusNotificationTo(node, dst_node_idx, msg);
+}
+
+/**
+ * @description: 按名称ID发送通知，名称ID由EBUS_NODE_ID在编译期得到
+ * @param {sEbusNode_t} *node
+ * @param {uint32_t} dst_node_id 目标节点名称ID
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+eEbusRst_t EbusNotificationById(sEbusNode_t *node, uint32_t dst_node_id, sEbusMsgItem_t *msg)
+{
+    if (node == RT_NULL || msg == RT_NULL)
+    {
+        LOG_E("[Ebus] Invalid parameters for notification");
+        return eEbusRst_ParamErr;
+    }
+
+    uint16_t dst_node_idx = EbusResolveNode(dst_node_id, RT_NULL);
+    if (dst_node_idx == EBUS_NODE_IDX_BROADCAST)
+    {
+        LOG_E("[Ebus] Target node not found for notification: id=0x%08X", dst_node_id);
+        return eEbusRst_NodeNotFound;
+    }
+
+    return EbusNotificationTo(node, dst_node_idx, msg);
+}
+
+/**
+ * @description: 异步Indication，通过回调通知结果
+ * @param {sEbusNode_t} *node 发送节点
+ * @param {char} *dst_node_name 目标节点名称
+ * @param {sEbusMsgItem_t} *msg 发送的消息
+ * @return {*} 执行结果
+ */
+eEbusRst_t EbusIndicationAsync(sEbusNode_t *node, char *dst_node_name, sEbusMsgItem_t *msg)
+{
+    if (node == RT_NULL || msg == RT_NULL || dst_node_name == RT_NULL)
+    {
+        LOG_E("[Ebus] Invalid parameters for async indication");
+        return eEbusRst_ParamErr;
+    }
+
+    LOG_D("[Ebus] Sending async indication: from=%s, to=%s, evt=%x",
+          node->name, dst_node_name, msg->evt_id);
+
+    uint16_t dst_node_idx = EbusResolveNode(EbusNameHash(dst_node_name), dst_node_name);
+    if (dst_node_idx == EBUS_NODE_IDX_BROADCAST)
+    {
+        LOG_E("[Ebus] Target node not found for async indication: %s", dst_node_name);
+        return eEbusRst_NodeNotFound;
+    }
+
+    return EbusIndicationTo(node, dst_node_idx, msg, RT_NULL, 0, 0);
+}
+
+/**
+ * @description: 按名称ID发送异步Indication
+ * @param {sEbusNode_t} *node 发送节点
+ * @param {uint32_t} dst_node_id 目标节点名称ID
+ * @param {sEbusMsgItem_t} *msg 发送的消息
+ * @return {*} 执行结果
+ */
+eEbusRst_t EbusIndicationAsyncById(sEbusNode_t *node, uint32_t dst_node_id, sEbusMsgItem_t *msg)
+{
+    if (node == RT_NULL || msg == RT_NULL)
+    {
+        LOG_E("[Ebus] Invalid parameters for async indication");
+        return eEbusRst_ParamErr;
+    }
+
+    uint16_t dst_node_idx = EbusResolveNode(dst_node_id, RT_NULL);
+    if (dst_node_idx == EBUS_NODE_IDX_BROADCAST)
+    {
+        LOG_E("[Ebus] Target node not found for async indication: id=0x%08X", dst_node_id);
+        return eEbusRst_NodeNotFound;
+    }
+
+    return EbusIndicationTo(node, dst_node_idx, msg, RT_NULL, 0, 0);
+}
+
+/**
+ * @description: 按名称ID发送异步Indication，登记上下文与应答超时
+ * @param {sEbusNode_t} *node 发送节点
+ * @param {uint32_t} dst_node_id 目标节点名称ID
+ * @param {sEbusMsgItem_t} *msg 发送的消息
+ * @param {void} *ctx 应答或超时回调时作为user_data返回
+ * @param {rt_tick_t} timeout 应答超时(tick)，0使用EBUS_RESPONSE_WAIT_TIME_MS，RT_WAITING_FOREVER不超时
+ * @return {*} 执行结果
+ */
+eEbusRst_t EbusIndicationAsyncEx(sEbusNode_t *node, uint32_t dst_node_id, sEbusMsgItem_t *msg,
+                                 void *ctx, rt_tick_t timeout)
+{
+    if (node == RT_NULL || msg == RT_NULL)
+    {
+        LOG_E("[Ebus] Invalid parameters for async indication");
+        return eEbusRst_ParamErr;
+    }
+
+    uint16_t dst_node_idx = EbusResolveNode(dst_node_id, RT_NULL);
+    if (dst_node_idx == EBUS_NODE_IDX_BROADCAST)
+    {
+        LOG_E("[Ebus] Target node not found for async indication: id=0x%08X", dst_node_id);
+        return eEbusRst_NodeNotFound;
+    }
+
+    if (timeout == 0)
+    {
+        timeout = rt_tick_from_millisecond(EBUS_RESPONSE_WAIT_TIME_MS);
+    }
+    else if (timeout == (rt_tick_t)RT_WAITING_FOREVER)
+    {
+        timeout = 0;
+    }
+
+    return EbusIndicationTo(node, dst_node_idx, msg, ctx, timeout, 0);
+}
+
+/**
+ * @description: 可重传指示，应答超时后以同一序列号重发，间隔按2倍退避，不超过EBUS_RETRY_MAX_INTERVAL_MS。
+ *               接收方按(源句柄,序列号)抑制重复，回调只执行一次，已响应时重发缓存的响应
+ * @param {sEbusNode_t} *node 发送节点
+ * @param {uint32_t} dst_node_id 目标节点名称ID
+ * @param {sEbusMsgItem_t} *msg 发送的消息
+ * @param {void} *ctx 应答或最终超时回调时作为user_data返回
+ * @param {rt_tick_t} timeout 首次应答超时(tick)，0使用EBUS_RESPONSE_WAIT_TIME_MS
+ * @param {uint8_t} retry_num 最大重传次数，重传全部超时后以eEBusEvtType_IndicationTimeoutCb回调
+ * @return {*} 目标队列满或被限流时不返回失败，等待重传
+ */
+eEbusRst_t EbusIndicationReliable(sEbusNode_t *node, uint32_t dst_node_id, sEbusMsgItem_t *msg, void *ctx,
+                                  rt_tick_t timeout, uint8_t retry_num)
+{
+    if (node == RT_NULL || msg == RT_NULL || retry_num == 0 || timeout == (rt_tick_t)RT_WAITING_FOREVER)
+    {
+        LOG_E("[Ebus] Invalid parameters for reliable indication");
+        return eEbusRst_ParamErr;
+    }
+
+    uint16_t dst_node_idx = EbusResolveNode(dst_node_id, RT_NULL);
+    if (dst_node_idx == EBUS_NODE_IDX_BROADCAST)
+    {
+        LOG_E("[Ebus] Target node not found for reliable indication: id=0x%08X", dst_node_id);
+        return eEbusRst_NodeNotFound;
+    }
+
+    if (timeout == 0)
+    {
+        timeout = rt_tick_from_millisecond(EBUS_RESPONSE_WAIT_TIME_MS);
+    }
+
+    return EbusIndicationTo(node, dst_node_idx, msg, ctx, timeout, retry_num);
+}
+
+/**
+ * @description: 汇聚指示，以同一序列号向多个目标发送指示，只占用一个等待响应项。全部响应到达或超时时
+ *               在请求方接收线程中调用on_complete，超时时交付已收到的部分响应。需在请求方接收线程中调用
+ * @param {sEbusNode_t} *node 发送节点
+ * @param {uint32_t} *dst_node_id 目标节点名称ID数组，不能重复
+ * @param {uint8_t} dst_num 目标数量，不超过EBUS_GATHER_MAX_DST
+ * @param {sEbusMsgItem_t} *msg 发送的消息
+ * @param {rt_tick_t} timeout 应答超时(tick)，0使用EBUS_RESPONSE_WAIT_TIME_MS，RT_WAITING_FOREVER不超时
+ * @param {EbusGatherCbPtr} on_complete 完成回调，gather->recv_mask标记已响应的目标
+ * @param {void} *ctx 完成回调的user_data
+ * @return {*} 至少向一个目标发出时返回成功，目标未找到、信用不足或队列满的目标不计入等待
+ */
+eEbusRst_t EbusIndicationGather(sEbusNode_t *node, const uint32_t *dst_node_id, uint8_t dst_num, sEbusMsgItem_t *msg,
+                                rt_tick_t timeout, EbusGatherCbPtr on_complete, void *ctx)
+{
+    if (node == RT_NULL || !node->init || msg == RT_NULL || dst_node_id == RT_NULL || dst_num == 0 ||
+        dst_num > EBUS_GATHER_MAX_DST)
+    {
+        LOG_E("[Ebus] Invalid parameters for gather indication");
+        return eEbusRst_ParamErr;
+    }
+
+    // 响应按目标节点匹配，重复的目标会使两个位置都等同一个响应，直接拒绝
+    for (int i = 1; i < dst_num; i++)
+    {
+        for (int j = 0; j < i; j++)
+        {
+            if (dst_node_id[i] == dst_node_id[j])
+            {
+                LOG_E("[Ebus] Duplicate target for gather indication: id=0x%08X", dst_node_id[i]);
+                return eEbusRst_ParamErr;
+            }
+        }
+    }
+
+    if (timeout == 0)
+    {
+        timeout = rt_tick_from_millisecond(EBUS_RESPONSE_WAIT_TIME_MS);
+    }
+    else if (timeout == (rt_tick_t)RT_WAITING_FOREVER)
+    {
+        timeout = 0;
+    }
+
+    // 分配汇聚表项
+    sEbusGather_t *gather = RT_NULL;
+    int gather_no;
+    rt_base_t level = rt_spin_lock_irqsave(&g_ebus_.gather_lock);
+    for (gather_no = 0; gather_no < EBUS_GATHER_NUM; gather_no++)
+    {
+        if (!g_ebus_.gather[gather_no].used)
+        {
+            gather = &g_ebus_.gather[gather_no];
+            gather->used = 1;
+            break;
+        }
+    }
+    rt_spin_unlock_irqrestore(&g_ebus_.gather_lock, level);
+    if (gather == RT_NULL)
+    {
+        LOG_E("[Ebus] No space for gather indication: node=%s", node->name);
+        return eEbusRst_NoMemory;
+    }
+
+    // 所有目标共用一个等待响应项
+    int wait_idx = EbusAllocWaitRespItem(node);
+    if (wait_idx < 0)
+    {
+        LOG_E("[Ebus] No space for wait response: node=%s", node->name);
+        EbusGatherRelease(gather);
+        return eEbusRst_NoMemory;
+    }
+
+    gather->dst_num = dst_num;
+    gather->seq_num = EbusGetSn(node);
+    gather->sent_mask = 0;
+    gather->recv_mask = 0;
+    gather->credit_mask = 0;
+    gather->on_complete = on_complete;
+    gather->ctx = ctx;
+
+    rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
+    sEbusWaitResp_t *wait_item = &node->wait_resp_list[wait_idx];
+    wait_item->seq_num = gather->seq_num;
+    wait_item->src_node_idx = node->node_idx;
+    wait_item->dst_node_idx = EBUS_NODE_IDX_BROADCAST;
+    wait_item->send_time = rt_tick_get();
+    wait_item->timeout = timeout;
+    wait_item->ctx = ctx;
+    wait_item->gather = (uint8_t)(gather_no + 1);
+    wait_item->state = eEbusMsgState_Sented;
+    if (timeout != 0)
+    {
+        rt_tick_t deadline = wait_item->send_time + timeout;
+        if (node->wait_resp_timed++ == 0 || (rt_int32_t)(deadline - node->resp_deadline) < 0)
+        {
+            node->resp_deadline = deadline;
+        }
+    }
+    rt_mutex_release(node->resp_mutex);
+
+    // 先登记全部目标再发送，避免先到的响应找不到目标
+    for (int i = 0; i < dst_num; i++)
+    {
+        uint8_t credit = 0;
+        gather->dst_node_idx[i] = EbusResolveNode(dst_node_id[i], RT_NULL);
+        if (gather->dst_node_idx[i] == EBUS_NODE_IDX_BROADCAST)
+        {
+            LOG_W("[Ebus] Target node not found for gather: id=0x%08X", dst_node_id[i]);
+            continue;
+        }
+        if (!EbusCreditTake(gather->dst_node_idx[i], &credit))
+        {
+            continue;
+        }
+        gather->sent_mask |= 1UL << i;
+        if (credit)
+        {
+            gather->credit_mask |= 1UL << i;
+        }
+    }
+
+    msg->type = eEbusMsgType_Indication;
+    msg->flag = 0;
+    msg->src_node_idx = node->node_idx;
+    msg->seq_num = gather->seq_num;
+    msg->timestamp = rt_tick_get();
+    for (int i = 0; i < dst_num; i++)
+    {
+        if (!(gather->sent_mask & (1UL << i)))
+        {
+            continue;
+        }
+        msg->dst_node_idx = gather->dst_node_idx[i];
+        if (EbusMsgSend(node, msg) != eEbusRst_Success)
+        {
+            // 未发出的目标不再等待，响应在本线程之后的接收中处理，此处修改不会与其竞争
+            gather->sent_mask &= ~(1UL << i);
+            if (gather->credit_mask & (1UL << i))
+            {
+                gather->credit_mask &= ~(1UL << i);
+                EbusCreditGive(gather->dst_node_idx[i]);
+            }
+        }
+    }
+
+    if (gather->sent_mask == 0)
+    {
+        LOG_E("[Ebus] Gather indication not sent to any target: node=%s", node->name);
+        EbusFreeWaitRespItem(node, wait_idx);
+        EbusGatherRelease(gather);
+        return eEbusRst_Fail;
+    }
+
+    LOG_D("[Ebus] Gather indication sent: seq=%d, from=%s, targets=0x%08X",
+          gather->seq_num, node->name, gather->sent_mask);
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 释放已超时的等待响应项，并以eEBusEvtType_IndicationTimeoutCb回调通知发送者，
+ *               需由节点的接收线程周期调用
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+void EbusWaitRespExpire(sEbusNode_t *node)
+{
+    sEbusWaitResp_t expired[EBUS_RESP_EXPIRE_BATCH];
+    sEbusMsgItem_t resend[EBUS_RESP_EXPIRE_BATCH];
+    int expired_num;
+    int resend_num;
+
+    if (node == RT_NULL || !node->init)
+    {
+        return;
+    }
+
+    do
+    {
+        // 未到最早超时时刻时不扫描等待列表
+        if (node->wait_resp_timed == 0)
+        {
+            return;
+        }
+        rt_tick_t now = rt_tick_get();
+        if ((rt_int32_t)(now - node->resp_deadline) < 0)
+        {
+            return;
+        }
+
+        rt_tick_t next_wait = RT_TICK_MAX / 2;
+        expired_num = 0;
+        resend_num = 0;
+
+        rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
+        for (int i = 0; i < node->wait_resp_num; i++)
+        {
+            sEbusWaitResp_t *item = &node->wait_resp_list[i];
+            // 可重传指示的响应可能在已标记Recved后丢失，同样需要超时重传
+            if (item->timeout == 0 || item->state == eEbusMsgState_Idle ||
+                (item->state == eEbusMsgState_Recved && item->retry == 0))
+            {
+                continue;
+            }
+            rt_tick_t waited = now - item->send_time;
+            if (waited < item->timeout)
+            {
+                if (item->timeout - waited < next_wait)
+                {
+                    next_wait = item->timeout - waited;
+                }
+                continue;
+            }
+            if (expired_num + resend_num == EBUS_RESP_EXPIRE_BATCH)
+            {
+                // 本批已满，剩余的超时项下一轮处理
+                next_wait = 0;
+                break;
+            }
+            sEbusRetry_t *retry = (item->retry != 0) ? &g_ebus_.retry[item->retry - 1] : RT_NULL;
+            if (retry != RT_NULL && retry->retry_left != 0)
+            {
+                // 以同一序列号重发，超时间隔加倍
+                rt_tick_t max_interval = rt_tick_from_millisecond(EBUS_RETRY_MAX_INTERVAL_MS);
+                rt_tick_t interval = item->timeout * 2;
+                if (interval > max_interval)
+                {
+                    interval = (item->timeout > max_interval) ? item->timeout : max_interval;
+                }
+                retry->retry_left--;
+                retry->msg.timestamp = now;
+                resend[resend_num++] = retry->msg;
+                item->send_time = now;
+                item->timeout = interval;
+                item->state = eEbusMsgState_Sented;
+                if (interval < next_wait)
+                {
+                    next_wait = interval;
+                }
+                continue;
+            }
+            expired[expired_num++] = *item;
+            EbusClearWaitRespItemLocked(node, item);
+        }
+        node->resp_deadline = now + next_wait;
+        rt_mutex_release(node->resp_mutex);
+
+        for (int i = 0; i < resend_num; i++)
+        {
+            node->stat.retry_cnt++;
+            LOG_D("[Ebus] Indication retransmit: node=%s, seq=%d, dst=0x%04X",
+                  node->name, resend[i].seq_num, resend[i].dst_node_idx);
+            EbusMsgSend(node, &resend[i]);
+        }
+
+        // 回调不持有锁，回调中可以再次发送指示
+        for (int i = 0; i < expired_num; i++)
+        {
+            EbusCreditGive(expired[i].credit ? expired[i].dst_node_idx : EBUS_NODE_IDX_BROADCAST);
+            if (expired[i].gather != 0)
+            {
+                // 汇聚指示超时交付已收到的部分响应
+                EbusGatherFinish(node, &g_ebus_.gather[expired[i].gather - 1], eEbusRst_Timeout);
+                continue;
+            }
+
+            EbusWaitRespTimeoutCb(node, &expired[i]);
+        }
+    } while (expired_num + resend_num == EBUS_RESP_EXPIRE_BATCH);
+}
+
+/**
+ * @description: 按源句柄发布广播或通知，不阻塞，可在中断和定时器回调中调用，序列号由调用者分配
+ * @param {uint16_t} src_node_idx
+ * @param {uint16_t} dst_node_idx 目标节点句柄，EBUS_NODE_IDX_BROADCAST为广播
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*}
+ */
+static eEbusRst_t EbusPublishIdx(uint16_t src_node_idx, uint16_t dst_node_idx, sEbusMsgItem_t *msg)
+{
+    msg->type = (dst_node_idx == EBUS_NODE_IDX_BROADCAST) ? eEbusMsgType_Broadcast : eEbusMsgType_Notification;
+    msg->flag = 0;
+    msg->src_node_idx = src_node_idx;
+    msg->dst_node_idx = dst_node_idx;
+    msg->timestamp = rt_tick_get();
+    EbusEvtAttrApply(msg);
+
+    // 本核暂存环为空时直接入队，目标线程只被唤醒一次；否则排在本核暂存消息之后保持顺序
+    sEbusIsrRing_t *ring = &g_ebus_.isr_ring[EBUS_CPU_SELF()];
+    if (!EbusIsrRingPending(ring) && EbusReadTryLock())
+    {
+        eEbusRst_t rst = EbusMsgRouteLocked(msg);
+        EbusReadUnlock();
+        return rst;
+    }
+
+    if (!EbusIsrRingPush(ring, msg))
+    {
+        rt_atomic_add(&ring->drop_cnt, 1);
+        return eEbusRst_QueueFull;
+    }
+    EbusIsrRingDrainOne(ring);
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 中断中发布广播或通知，不阻塞、不持有互斥量。无写者时直接投递到目标队列，
+ *               否则暂存到无锁暂存环，由写者解锁时转发
+ * @param {sEbusNode_t} *node 发送节点
+ * @param {uint16_t} dst_node_idx 目标节点句柄，EBUS_NODE_IDX_BROADCAST为广播
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*} 暂存环满返回eEbusRst_QueueFull
+ */
+eEbusRst_t EbusPublishFromISR(sEbusNode_t *node, uint16_t dst_node_idx, sEbusMsgItem_t *msg)
+{
+    if (!g_ebus_.init || node == RT_NULL || !node->init || msg == RT_NULL || msg->len > EBUS_MAX_MSG_SIZE)
+    {
+        return eEbusRst_ParamErr;
     }
 
-    // 查找空闲槽位
-    int idle_idx = EbusFindIdleIdx();
-    if (idle_idx < 0)
+    eEbusRatePolicy_t policy;
+    if (!EbusRateAcquire(node, msg->evt_id, RT_FALSE, &policy))
     {
-        LOG_E("[Ebus] No available slots for node: %s", name);
-        rt_mq_delete(node->msg_queue);
-        rt_mutex_delete(node->resp_mutex);
-        rt_free(node);
-        return RT_NULL;
+        return (policy == eEbusRatePolicy_Drop) ? eEbusRst_Success : eEbusRst_RateLimited;
     }
+    msg->seq_num = EbusGetSn(node);
+    return EbusPublishIdx(node->node_idx, dst_node_idx, msg);
+}
 
-    // 注册到总线
-    EbusBusInit((uint8_t)idle_idx, node);
+/**
+ * @description: 定时项挂入时间轮。到期时刻与当前tick在同一级页内时放入该级槽位，
+ *               级数越高粒度越粗，到达该槽位时逐级下放；超出最高级的放入溢出链表
+ * @param {sEbusTimer_t} *tmr
+ * @return {*}
+ */
+static void EbusTimerInsertLocked(sEbusTimer_t *tmr)
+{
+    sEbusTimer_t **head = &g_ebus_tmr_.far;
+    rt_tick_t cur = g_ebus_tmr_.cur;
 
-    // 检查是否初始化成功
-    if (!node->init)
+    for (int level = 0; level < EBUS_TIMER_WHEEL_LEVEL; level++)
     {
-        LOG_E("[Ebus] Failed to initialize node: %s", name);
-        EbusBusDeinit(idle_idx);
-        rt_mq_delete(node->msg_queue);
-        rt_mutex_delete(node->resp_mutex);
-        rt_free(node);
-        return RT_NULL;
+        int shift = EBUS_TIMER_WHEEL_BITS * (level + 1);
+        if ((tmr->expire >> shift) == (cur >> shift))
+        {
+            head = &g_ebus_tmr_.wheel[level][(tmr->expire >> (shift - EBUS_TIMER_WHEEL_BITS)) & EBUS_TIMER_WHEEL_MASK];
+            break;
+        }
     }
 
-    LOG_D("[Ebus] Node created successfully: name=%s, idx=%d", node->name, node->node_idx);
-    return node;
+    tmr->next = *head;
+    if (tmr->next != RT_NULL)
+    {
+        tmr->next->pprev = &tmr->next;
+    }
+    tmr->pprev = head;
+    *head = tmr;
 }
 
 /**
- * @description: 总线内节点销毁
- * @param {sEbusNode_t} *node
+ * @description: 定时项移出时间轮
+ * @param {sEbusTimer_t} *tmr
  * @return {*}
  */
-void EbusNodeDestory(sEbusNode_t *node)
+static void EbusTimerUnlinkLocked(sEbusTimer_t *tmr)
 {
-    if (node == RT_NULL)
+    if (tmr->pprev == RT_NULL)
     {
-        LOG_E("[Ebus] Attempt to destroy null node");
         return;
     }
-
-    if (!node->init)
+    *tmr->pprev = tmr->next;
+    if (tmr->next != RT_NULL)
     {
-        LOG_W("[Ebus] Node not initialized: %s", node->name);
-        return;
+        tmr->next->pprev = tmr->pprev;
     }
+    tmr->next = RT_NULL;
+    tmr->pprev = RT_NULL;
+}
 
-    LOG_D("[Ebus] Destroying node: %s, idx=%d", node->name, node->node_idx);
-
-    // 从总线注销
-    EbusBusDeinit(node->node_idx);
-
-    // 删除消息队列和互斥量
-    rt_mq_delete(node->msg_queue);
-    LOG_D("[Ebus] Message queue deleted for node: %s", node->name);
-
-    rt_mutex_delete(node->resp_mutex);
-    LOG_D("[Ebus] Response mutex deleted for node: %s", node->name);
-
-    // 清理节点数据
-    node->node_idx = 0;
-    node->init = 0;
-    rt_free(node);
-
-    LOG_D("[Ebus] Node destroyed successfully: %s", node->name);
+/**
+ * @description: 释放定时项，代数递增使旧句柄失效
+ * @param {sEbusTimer_t} *tmr
+ * @return {*}
+ */
+static void EbusTimerFreeLocked(sEbusTimer_t *tmr)
+{
+    EbusTimerUnlinkLocked(tmr);
+    tmr->used = 0;
+    tmr->gen++;
+    g_ebus_tmr_.active--;
 }
 
 /**
- * @description: 接收
- * @param {sEbusNode_t} *node
- * @param {sEbusMsgItem_t} *msg
- * @param {uint32_t} timeout
+ * @description: 把一个槽位(或溢出链表)上的定时项按当前tick重新挂入，实现逐级下放
+ * @param {sEbusTimer_t} **head
  * @return {*}
  */
-eEbusRst_t EbusMsgWaitRecv(sEbusNode_t *node, sEbusMsgItem_t *msg, uint32_t timeout)
+static void EbusTimerCascadeLocked(sEbusTimer_t **head)
 {
-    if (node == RT_NULL || !node->init || msg == RT_NULL)
+    sEbusTimer_t *tmr = *head;
+    *head = RT_NULL;
+    while (tmr != RT_NULL)
     {
-        LOG_E("[Ebus] Invalid parameters for message receive");
-        return eEbusRst_ParamErr;
+        sEbusTimer_t *next = tmr->next;
+        tmr->pprev = RT_NULL;
+        EbusTimerInsertLocked(tmr);
+        tmr = next;
     }
+}
 
-    LOG_D("[Ebus] Waiting for message: node=%s, timeout=%d", node->name, timeout);
+/**
+ * @description: 时间轮驱动，追赶到当前tick并发布所有到期消息，无定时项时停止
+ * @param {void} *parameter
+ * @return {*}
+ */
+static void EbusTimerTick(void *parameter)
+{
+    sEbusMsgItem_t msg;
+    rt_base_t level = rt_spin_lock_irqsave(&g_ebus_tmr_.lock);
 
-    rt_ssize_t len = rt_mq_recv(node->msg_queue, msg, sizeof(sEbusMsgItem_t), timeout);
-    if (len > 0)
+    while (g_ebus_tmr_.active != 0 && (rt_int32_t)(rt_tick_get() - g_ebus_tmr_.cur) > 0)
     {
-        LOG_D("[Ebus] Message received: node=%s, type=%d, seq=%d, src=%d, dst=%d",
-              node->name, msg->type, msg->seq_num, msg->src_node_idx, msg->dst_node_idx);
+        rt_tick_t cur = ++g_ebus_tmr_.cur;
 
-        if (msg->type == eEbusMsgType_Indication && node->Evtcb != RT_NULL)
+        // 先从高级向低级下放，再处理第0级当前槽位
+        if ((cur & ((1U << (EBUS_TIMER_WHEEL_BITS * EBUS_TIMER_WHEEL_LEVEL)) - 1)) == 0)
         {
-            LOG_D("[Ebus] Processing indication: seq=%d, src=%d, dst=%d",
-                  msg->seq_num, msg->src_node_idx, msg->dst_node_idx);
-            sEbusNode_t *ack_node = (sEbusNode_t *)EbusFindNodeByIdx(msg->src_node_idx);
-            if (ack_node != RT_NULL)
+            EbusTimerCascadeLocked(&g_ebus_tmr_.far);
+        }
+        for (int lv = EBUS_TIMER_WHEEL_LEVEL - 1; lv > 0; lv--)
+        {
+            if ((cur & ((1U << (EBUS_TIMER_WHEEL_BITS * lv)) - 1)) == 0)
             {
-                node->Evtcb(eEBusEvtType_IndicationCb, node, msg, ack_node);
-                LOG_D("[Ebus] Indication callback invoked");
+                EbusTimerCascadeLocked(&g_ebus_tmr_.wheel[lv][(cur >> (EBUS_TIMER_WHEEL_BITS * lv)) & EBUS_TIMER_WHEEL_MASK]);
+            }
+        }
+
+        sEbusTimer_t **slot = &g_ebus_tmr_.wheel[0][cur & EBUS_TIMER_WHEEL_MASK];
+        while (*slot != RT_NULL)
+        {
+            sEbusTimer_t *tmr = *slot;
+            uint16_t dst_node_idx = tmr->msg.dst_node_idx;
+
+            // 到期的发布同样从发送节点和事件的令牌桶取令牌，不能阻塞，延迟策略按拒绝处理，本次不发布
+            eEbusRatePolicy_t policy;
+            rt_bool_t pass = EbusRateAcquire(tmr->node, tmr->msg.evt_id, RT_FALSE, &policy);
+            EbusTimerUnlinkLocked(tmr);
+            if (pass)
+            {
+                rt_memcpy(&msg, &tmr->msg, EBUS_MSG_ITEM_SIZE(tmr->msg.len));
+                msg.seq_num = EbusGetSn(tmr->node);
+            }
+            if (tmr->period != 0)
+            {
+                tmr->expire += tmr->period;
+                EbusTimerInsertLocked(tmr);
             }
             else
             {
-                LOG_W("[Ebus] Source node not found for indication: idx=%d", msg->src_node_idx);
+                EbusTimerFreeLocked(tmr);
             }
-            return eEbusRst_OtherEvt;
-        }
-        else if (msg->type == eEbusMsgType_Response && node->Evtcb != RT_NULL)
-        {
-            LOG_D("[Ebus] Processing response: seq=%d, src=%d, dst=%d",
-                  msg->seq_num, msg->src_node_idx, msg->dst_node_idx);
-            node->Evtcb(eEBusEvtType_IndicationAckCb, node, msg, RT_NULL);
-            EbusProcessResponse(node, msg);
-            return eEbusRst_OtherEvt;
+
+            // 发布时不持有时间轮锁，期间取消的周期项从下一次起不再发布
+            rt_spin_unlock_irqrestore(&g_ebus_tmr_.lock, level);
+            if (pass)
+            {
+                EbusPublishIdx(msg.src_node_idx, dst_node_idx, &msg);
+            }
+            level = rt_spin_lock_irqsave(&g_ebus_tmr_.lock);
         }
-        return eEbusRst_Success;
-    }
-    else if (len == -RT_ETIMEOUT)
-    {
-        LOG_D("[Ebus] Message receive timeout: node=%s", node->name);
-        return eEbusRst_Timeout;
     }
-    else
+
+    if (g_ebus_tmr_.active == 0 && g_ebus_tmr_.running)
     {
-        LOG_E("[Ebus] Message receive failed: node=%s, err=%d", node->name, len);
-        return eEbusRst_Fail;
+        g_ebus_tmr_.running = 0;
+        rt_timer_stop(&g_ebus_tmr_.timer);
     }
+    rt_spin_unlock_irqrestore(&g_ebus_tmr_.lock, level);
 }
 
 /**
- * @description: 接收
- * @param {sEbusNode_t} *node
- * @param {sEbusMsgItem_t} *msg
- * @return {*}
- */
-eEbusRst_t EbusMsgRecv(sEbusNode_t *node, sEbusMsgItem_t *msg)
-{
-    LOG_D("[Ebus] Try receive message: node=%s", node->name);
-    return EbusMsgWaitRecv(node, msg, 0);
-}
-
-/**
- * @description: 消息广播
+ * @description: 分配定时项并挂入时间轮，需要时启动驱动定时器
  * @param {sEbusNode_t} *node
- * @param {char} dst_node_name
+ * @param {uint16_t} dst_node_idx
  * @param {sEbusMsgItem_t} *msg
+ * @param {rt_tick_t} delay 首次发布的延时
+ * @param {rt_tick_t} period 发布周期，0表示只发布一次
+ * @param {uint16_t} *handle 输出取消句柄，可为RT_NULL
  * @return {*}
  */
-eEbusRst_t EbusBroadcast(sEbusNode_t *node, sEbusMsgItem_t *msg)
+static eEbusRst_t EbusTimerAdd(sEbusNode_t *node, uint16_t dst_node_idx, sEbusMsgItem_t *msg,
+                               rt_tick_t delay, rt_tick_t period, uint16_t *handle)
 {
-    if (node == RT_NULL || !node->init || msg == RT_NULL)
+    if (!g_ebus_.init || node == RT_NULL || !node->init || msg == RT_NULL || msg->len > EBUS_MAX_MSG_SIZE)
     {
-        LOG_E("[Ebus] Invalid parameters for broadcast");
+        LOG_E("[Ebus] Invalid parameters for timed publish");
         return eEbusRst_ParamErr;
     }
 
-    LOG_D("[Ebus] Broadcasting: from node=%s, evt=%x", node->name, msg->evt_id);
+    eEbusRst_t rst = eEbusRst_NoMemory;
+    rt_base_t level = rt_spin_lock_irqsave(&g_ebus_tmr_.lock);
+    for (int i = 0; i < EBUS_TIMER_NUM; i++)
+    {
+        sEbusTimer_t *tmr = &g_ebus_tmr_.pool[i];
+        if (tmr->used)
+        {
+            continue;
+        }
 
-    msg->type = eEbusMsgType_Broadcast;
-    msg->src_node_idx = node->node_idx;
-    msg->dst_node_idx = 0xFF;
-    msg->seq_num = EbusGetSn();
-    msg->timestamp = rt_tick_get();
+        if (!g_ebus_tmr_.running)
+        {
+            // 驱动定时器停止期间时间轮为空，从当前tick重新开始
+            g_ebus_tmr_.cur = rt_tick_get();
+            g_ebus_tmr_.running = 1;
+            rt_timer_start(&g_ebus_tmr_.timer);
+        }
 
-    return EbusMsgSend(node, msg);
-}
+        rt_memcpy(&tmr->msg, msg, EBUS_MSG_ITEM_SIZE(msg->len));
+        tmr->msg.src_node_idx = node->node_idx;
+        tmr->node = node;
+        tmr->msg.dst_node_idx = dst_node_idx;
+        tmr->used = 1;
+        tmr->period = period;
+        tmr->expire = g_ebus_tmr_.cur + ((delay != 0) ? delay : 1);
+        EbusTimerInsertLocked(tmr);
+        g_ebus_tmr_.active++;
 
-/**
- * @description: 消息通知无应答
- * @param {sEbusNode_t} *node
- * @param {char} dst_node_name
- * @param {sEbusMsgItem_t} *msg
- * @return {*}
- */
-eEbusRst_t EbusNotification(sEbusNode_t *node, char *dst_node_name, sEbusMsgItem_t *msg)
-{
-    if (node == RT_NULL || msg == RT_NULL || dst_node_name == RT_NULL)
-    {
-        LOG_E("[Ebus] Invalid parameters for notification");
-        return eEbusRst_ParamErr;
+        if (handle != RT_NULL)
+        {
+            *handle = EBUS_TIMER_HANDLE_MAKE(i, tmr->gen);
+        }
+        rst = eEbusRst_Success;
+        break;
     }
+    rt_spin_unlock_irqrestore(&g_ebus_tmr_.lock, level);
 
-    LOG_D("[Ebus] Sending notification: from=%s, to=%s, evt=%x",
-          node->name, dst_node_name, msg->evt_id);
-
-    sEbusNode_t *dst_node = EbusFindNodeByName(dst_node_name);
-    if (dst_node == RT_NULL)
+    if (rst != eEbusRst_Success)
     {
-        LOG_E("[Ebus] Target node not found for notification: %s", dst_node_name);
-        return eEbusRst_NodeNotFound;
+        LOG_E("[Ebus] No free timer for timed publish: node=%s", node->name);
     }
+    return rst;
+}
 
-    msg->type = eEbusMsgType_Notification;
-    msg->src_node_idx = node->node_idx;
-    msg->dst_node_idx = dst_node->node_idx;
-    msg->seq_num = EbusGetSn();
-    msg->timestamp = rt_tick_get();
-
-    return EbusMsgSend(node, msg);
+/**
+ * @description: 延时发布广播或通知，到期时由总线时间轮发布，发布时刻填写时间戳和序列号
+ * @param {sEbusNode_t} *node 发送节点
+ * @param {uint16_t} dst_node_idx 目标节点句柄，EBUS_NODE_IDX_BROADCAST为广播
+ * @param {sEbusMsgItem_t} *msg 消息内容在调用时拷贝
+ * @param {rt_tick_t} delay 延时(tick)
+ * @param {uint16_t} *handle 输出取消句柄，可为RT_NULL
+ * @return {*} 定时项用尽返回eEbusRst_NoMemory
+ */
+eEbusRst_t EbusPublishAfter(sEbusNode_t *node, uint16_t dst_node_idx, sEbusMsgItem_t *msg, rt_tick_t delay,
+                            uint16_t *handle)
+{
+    return EbusTimerAdd(node, dst_node_idx, msg, delay, 0, handle);
 }
 
 /**
- * @description: 异步Indication，通过回调通知结果
+ * @description: 周期发布广播或通知，首次在一个周期后发布，直到取消或发送节点销毁
  * @param {sEbusNode_t} *node 发送节点
- * @param {char} *dst_node_name 目标节点名称
- * @param {sEbusMsgItem_t} *msg 发送的消息
- * @return {*} 执行结果
+ * @param {uint16_t} dst_node_idx 目标节点句柄，EBUS_NODE_IDX_BROADCAST为广播
+ * @param {sEbusMsgItem_t} *msg 消息内容在调用时拷贝
+ * @param {rt_tick_t} period 周期(tick)，不能为0
+ * @param {uint16_t} *handle 输出取消句柄，可为RT_NULL
+ * @return {*}
  */
-eEbusRst_t EbusIndicationAsync(sEbusNode_t *node, char *dst_node_name, sEbusMsgItem_t *msg)
+eEbusRst_t EbusPublishEvery(sEbusNode_t *node, uint16_t dst_node_idx, sEbusMsgItem_t *msg, rt_tick_t period,
+                            uint16_t *handle)
 {
-    if (node == RT_NULL || msg == RT_NULL || dst_node_name == RT_NULL)
+    if (period == 0)
     {
-        LOG_E("[Ebus] Invalid parameters for async indication");
         return eEbusRst_ParamErr;
     }
+    return EbusTimerAdd(node, dst_node_idx, msg, period, period, handle);
+}
 
-    LOG_D("[Ebus] Sending async indication: from=%s, to=%s, evt=%x",
-          node->name, dst_node_name, msg->evt_id);
-
-    sEbusNode_t *dst_node = EbusFindNodeByName(dst_node_name);
-    if (dst_node == RT_NULL)
+/**
+ * @description: 取消延时/周期发布
+ * @param {uint16_t} handle EbusPublishAfter/EbusPublishEvery输出的句柄
+ * @return {*} 句柄已失效(已发布或已取消)返回eEbusRst_NodeNotFound
+ */
+eEbusRst_t EbusPublishCancel(uint16_t handle)
+{
+    uint16_t idx = EBUS_TIMER_HANDLE_IDX(handle);
+    if (handle == EBUS_TIMER_HANDLE_NONE || idx >= EBUS_TIMER_NUM)
     {
-        LOG_E("[Ebus] Target node not found for async indication: %s", dst_node_name);
-        return eEbusRst_NodeNotFound;
+        return eEbusRst_ParamErr;
     }
 
-    // 分配等待响应项
-    int wait_idx = EbusAllocWaitRespItem(node);
-    if (wait_idx < 0)
+    eEbusRst_t rst = eEbusRst_NodeNotFound;
+    rt_base_t level = rt_spin_lock_irqsave(&g_ebus_tmr_.lock);
+    sEbusTimer_t *tmr = &g_ebus_tmr_.pool[idx];
+    if (tmr->used && tmr->gen == EBUS_TIMER_HANDLE_GEN(handle))
     {
-        LOG_E("[Ebus] No space for wait response: node=%s", node->name);
-        return eEbusRst_NoMemory;
+        EbusTimerFreeLocked(tmr);
+        rst = eEbusRst_Success;
     }
+    rt_spin_unlock_irqrestore(&g_ebus_tmr_.lock, level);
+    return rst;
+}
 
-    // 设置消息参数
-    msg->type = eEbusMsgType_Indication;
-    msg->src_node_idx = node->node_idx;
-    msg->dst_node_idx = dst_node->node_idx;
-    msg->seq_num = EbusGetSn();
-    msg->timestamp = rt_tick_get();
-
-    LOG_D("[Ebus] Async indication configured: seq=%d, wait_idx=%d", msg->seq_num, wait_idx);
-
-    // 配置等待项
-    rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
-    sEbusWaitResp_t *wait_item = &node->wait_resp_list[wait_idx];
-    wait_item->seq_num = msg->seq_num;
-    wait_item->src_node_idx = node->node_idx;
-    wait_item->dst_node_idx = dst_node->node_idx;
-    wait_item->send_time = rt_tick_get();
-    wait_item->state = eEbusMsgState_Sented;
-    rt_mutex_release(node->resp_mutex);
-
-    // 发送消息
-    eEbusRst_t send_result = EbusMsgSend(node, msg);
-    if (send_result != eEbusRst_Success)
-    {
-        LOG_E("[Ebus] Async indication send failed: result=%d", send_result);
-        EbusFreeWaitRespItem(node, wait_idx);
-    }
-    else
+/**
+ * @description: 取消节点的全部延时/周期发布，节点销毁时调用
+ * @param {sEbusNode_t} *node
+ * @return {*}
+ */
+static void EbusTimerCancelNode(sEbusNode_t *node)
+{
+    rt_base_t level = rt_spin_lock_irqsave(&g_ebus_tmr_.lock);
+    for (int i = 0; i < EBUS_TIMER_NUM && g_ebus_tmr_.active != 0; i++)
     {
-        LOG_D("[Ebus] Async indication sent: seq=%d, from=%s to %s",
-              msg->seq_num, node->name, dst_node->name);
+        sEbusTimer_t *tmr = &g_ebus_tmr_.pool[i];
+        if (tmr->used && tmr->msg.src_node_idx == node->node_idx)
+        {
+            EbusTimerFreeLocked(tmr);
+        }
     }
-
-    return send_result;
+    rt_spin_unlock_irqrestore(&g_ebus_tmr_.lock, level);
 }
 
 /**
@@ -738,17 +4330,67 @@ eEbusRst_t EbusResponse(sEbusNode_t *node, sEbusNode_t *ack_node, sEbusMsgItem_t
 
     // 设置响应消息参数
     msg->type = eEbusMsgType_Response;
+    msg->flag = 0;
     msg->src_node_idx = node->node_idx;
     msg->dst_node_idx = ack_node->node_idx;
     msg->timestamp = rt_tick_get();
 
-    // 更新等待响应项状态
-    int idx = EbusFindWaitRespItem(ack_node, msg->seq_num);
+#if EBUS_DEDUP_ENABLE
+    // 可重传指示的响应缓存在重复抑制窗口中，重复的指示到达时重发
+    rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
+    sEbusDedupSrc_t *src = EbusDedupSrcLocked(node, ack_node->node_idx, RT_FALSE);
+    for (int i = 0; src != RT_NULL && i < EBUS_DEDUP_WINDOW; i++)
+    {
+        sEbusDedup_t *dedup = &src->entry[i];
+        if (dedup->state == eEbusMsgState_Sented && dedup->seq_num == msg->seq_num && msg->len <= EBUS_MAX_MSG_SIZE)
+        {
+            dedup->state = eEbusMsgState_Recved;
+            dedup->evt_id = msg->evt_id;
+            dedup->len = msg->len;
+            rt_memcpy(dedup->data, msg->data, msg->len);
+            msg->flag = EBUS_MSG_FLAG_RETRY;
+            break;
+        }
+    }
+    rt_mutex_release(node->resp_mutex);
+#endif
+
+    eEbusRst_t rst = EbusMsgSend(node, msg);
+    if (rst != eEbusRst_Success)
+    {
+        // 响应未送达，等待项保持Sented由请求方按超时处理；本节点的信用立即归还
+        rt_bool_t give = RT_FALSE;
+        int idx = EbusFindWaitRespItem(ack_node, msg->seq_num, node->node_idx);
+        if (idx >= 0)
+        {
+            rt_mutex_take(ack_node->resp_mutex, RT_WAITING_FOREVER);
+            sEbusWaitResp_t *wait_item = &ack_node->wait_resp_list[idx];
+            if (wait_item->state == eEbusMsgState_Sented && wait_item->seq_num == msg->seq_num &&
+                wait_item->gather == 0 && wait_item->credit && wait_item->dst_node_idx == node->node_idx)
+            {
+                wait_item->credit = 0;
+                give = RT_TRUE;
+            }
+            rt_mutex_release(ack_node->resp_mutex);
+        }
+        if (give)
+        {
+            EbusCreditGive(node->node_idx);
+        }
+        return rst;
+    }
+
+    // 响应已入队，更新等待响应项状态；请求方可能已处理响应并释放等待项
+    int idx = EbusFindWaitRespItem(ack_node, msg->seq_num, node->node_idx);
     if (idx >= 0)
     {
         rt_mutex_take(ack_node->resp_mutex, RT_WAITING_FOREVER);
         sEbusWaitResp_t *wait_item = &ack_node->wait_resp_list[idx];
-        if (wait_item->state == eEbusMsgState_Sented)
+        if (wait_item->gather != 0)
+        {
+            // 汇聚指示等待全部目标的响应，保持Sented以便超时时交付部分结果
+        }
+        else if (wait_item->state == eEbusMsgState_Sented)
         {
             wait_item->state = eEbusMsgState_Recved;
             LOG_D("[Ebus] Wait item state updated to Recved: seq=%d", msg->seq_num);
@@ -762,11 +4404,11 @@ eEbusRst_t EbusResponse(sEbusNode_t *node, sEbusNode_t *ack_node, sEbusMsgItem_t
     }
     else
     {
-        LOG_W("[Ebus] Wait item not found for response: seq=%d, ack_node=%s",
+        LOG_D("[Ebus] Wait item not found for response: seq=%d, ack_node=%s",
               msg->seq_num, ack_node->name);
     }
 
-    return EbusMsgSend(node, msg);
+    return rst;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -787,11 +4429,11 @@ void ebus_show(void)
     uint32_t current_tick = rt_tick_get();
     rt_kprintf("Ebus Wait Response Info - Current tick: %d\n", current_tick);
 
-    rt_mutex_take(g_ebus_.bus_mutex, RT_WAITING_FOREVER);
+    EbusReadLock();
 
-    for (int node_idx = 0; node_idx < EBUS_MAX_NODE_NUM; node_idx++)
+    for (int slot_no = 0; slot_no < g_ebus_.slot_cap; slot_no++)
     {
-        sEbusNode_t *node = g_ebus_.node_tbl[node_idx];
+        sEbusNode_t *node = g_ebus_.node_tbl[slot_no];
         if (node == RT_NULL || !node->init)
         {
             continue;
@@ -799,10 +4441,10 @@ void ebus_show(void)
 
         rt_mutex_take(node->resp_mutex, RT_WAITING_FOREVER);
 
-        rt_kprintf("\nNode: %s (ID:%d)\n", node->name, node->node_idx);
+        rt_kprintf("\nNode: %s (ID:0x%04X)\n", node->name, node->node_idx);
 
         int active_count = 0;
-        for (int slot_idx = 0; slot_idx < EBUS_NODE_MAX_RESP_WAIT_NUM; slot_idx++)
+        for (int slot_idx = 0; slot_idx < node->wait_resp_num; slot_idx++)
         {
             sEbusWaitResp_t *item = &node->wait_resp_list[slot_idx];
 
@@ -826,7 +4468,7 @@ void ebus_show(void)
                     break;
                 }
 
-                rt_kprintf("  Slot[%d]: Seq=0x%04X, State=%s, Src=%d->Dst=%d, SendTime=%d, Wait=%dms\n",
+                rt_kprintf("  Slot[%d]: Seq=0x%08X, State=%s, Src=0x%04X->Dst=0x%04X, SendTime=%d, Wait=%dms\n",
                            slot_idx,
                            item->seq_num,
                            state_str,
@@ -843,14 +4485,74 @@ void ebus_show(void)
         }
         else
         {
-            rt_kprintf("  Active slots: %d/%d\n", active_count, EBUS_NODE_MAX_RESP_WAIT_NUM);
+            rt_kprintf("  Active slots: %d/%d\n", active_count, node->wait_resp_num);
         }
 
         rt_mutex_release(node->resp_mutex);
     }
 
-    rt_mutex_release(g_ebus_.bus_mutex);
+    EbusReadUnlock();
     rt_kprintf("End of ebus wait response info\n");
 }
 MSH_CMD_EXPORT(ebus_show, show all ebus wait response info);
 
+/**
+ * @description: 显示各节点容量配置、运行期最高水位与容量建议
+ * @return {*}
+ */
+void ebus_sizing(void)
+{
+    if (!g_ebus_.init)
+    {
+        rt_kprintf("Ebus not initialized!\n");
+        return;
+    }
+
+    rt_kprintf("%-16s %11s %11s %7s %11s %11s %7s %7s %7s %8s %7s %7s\n",
+               "Node", "msg(hwm/n)", "size(hwm/n)", "drops", "resp(hwm/n)", "resp_full", "miss", "expired", "limited",
+               "filtered", "retry", "hint");
+
+    EbusReadLock();
+    for (int slot_no = 0; slot_no < g_ebus_.slot_cap; slot_no++)
+    {
+        sEbusNode_t *node = g_ebus_.node_tbl[slot_no];
+        if (node == RT_NULL || !node->init)
+        {
+            continue;
+        }
+
+        sEbusNodeCfg_t hint;
+        EbusNodeSizingHint(node, &hint);
+        rt_kprintf("%-16s %5d/%-5d %5d/%-5d %7d %5d/%-5d %11d %7d %7d %7d %8d %7d %d/%d/%d\n",
+                   node->name,
+                   node->stat.msg_hwm, node->msg_queue->max_msgs,
+                   node->stat.msg_len_hwm, node->msg_size,
+                   node->stat.queue_full_cnt,
+                   node->stat.resp_wait_hwm, node->wait_resp_num,
+                   node->stat.resp_full_cnt,
+                   node->stat.deadline_miss_cnt,
+                   node->stat.expired_cnt,
+                   node->rate.limited_cnt,
+                   node->stat.filtered_cnt,
+                   node->stat.retry_cnt,
+                   hint.msg_num, hint.msg_size, hint.resp_wait_num);
+    }
+    EbusReadUnlock();
+
+    int isr_drop = 0;
+    for (int i = 0; i < EBUS_CPU_NUM; i++)
+    {
+        isr_drop += (int)rt_atomic_load(&g_ebus_.isr_ring[i].drop_cnt);
+    }
+    rt_kprintf("isr ring: %d x %d slots, drops %d\n", EBUS_CPU_NUM, EBUS_ISR_RING_SIZE, isr_drop);
+    for (int i = 0; i < g_ebus_.evt_attr_num; i++)
+    {
+        sEbusRate_t *rate = &g_ebus_.evt_attr[i].rate;
+        if (rate->rate != 0)
+        {
+            rt_kprintf("evt 0x%04X rate %d/s burst %d limited %d\n",
+                       g_ebus_.evt_attr[i].evt_id, rate->rate, rate->burst, rate->limited_cnt);
+        }
+    }
+}
+MSH_CMD_EXPORT(ebus_sizing, show ebus node sizing report);
@@ -1,14 +1,128 @@
 #ifndef _EBUS_H_
 #define _EBUS_H_
 
+#include <stddef.h>
 #include "rtthread.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef EBUS_NAME_LEN
 #define EBUS_NAME_LEN               (32)    //ebus名称长度
-#define EBUS_MAX_NODE_NUM           (10)    //ebus节点数量
-#define EBUS_MAX_MSG_SIZE           (8)     //消息最大长度
-#define EBUS_MAX_MSG_NUM            (10)    //消息数量
-#define EBUS_NODE_MAX_RESP_WAIT_NUM (10)    //节点最大的等待回应数量
-#define EBUS_RESPONSE_WAIT_TIME_MS  (1000)  //节点最大等待时间
+#endif
+#ifndef EBUS_MAX_NODE_NUM
+#define EBUS_MAX_NODE_NUM           (10)    //ebus初始节点数量，超出后按需扩容
+#endif
+#ifndef EBUS_NODE_SLOT_BITS
+#define EBUS_NODE_SLOT_BITS         (10)    //节点句柄中槽位索引位数，其余高位为代数
+#endif
+#ifndef EBUS_MAX_MSG_SIZE
+#define EBUS_MAX_MSG_SIZE           (8)     //消息最大长度，节点可配置的消息长度上限
+#endif
+#ifndef EBUS_MAX_MSG_NUM
+#define EBUS_MAX_MSG_NUM            (10)    //默认消息数量
+#endif
+#ifndef EBUS_NODE_MAX_RESP_WAIT_NUM
+#define EBUS_NODE_MAX_RESP_WAIT_NUM (10)    //默认节点最大的等待回应数量
+#endif
+#ifndef EBUS_RESPONSE_WAIT_TIME_MS
+#define EBUS_RESPONSE_WAIT_TIME_MS  (1000)  //默认应答超时时间
+#endif
+#ifndef EBUS_ISR_RING_SIZE
+#define EBUS_ISR_RING_SIZE          (8)     //中断发布暂存环容量，须为2的幂
+#endif
+#ifndef EBUS_DIRECT_MAX_DEPTH
+#define EBUS_DIRECT_MAX_DEPTH       (4)     //直接投递的最大嵌套深度
+#endif
+#ifndef EBUS_EXEC_MAX_WORKER
+#define EBUS_EXEC_MAX_WORKER        (8)     //执行器最大工作线程数量
+#endif
+#ifndef EBUS_EXEC_BATCH
+#define EBUS_EXEC_BATCH             (8)     //工作线程单次执行一个节点的最大消息数量
+#endif
+#ifndef EBUS_EXEC_THREAD_PRIORITY
+#define EBUS_EXEC_THREAD_PRIORITY   (20)    //执行器工作线程优先级
+#endif
+#ifndef EBUS_EXEC_THREAD_STACK_SIZE
+#define EBUS_EXEC_THREAD_STACK_SIZE (2048)  //执行器工作线程栈大小
+#endif
+#ifndef EBUS_EVT_ATTR_NUM
+#define EBUS_EVT_ATTR_NUM           (8)     //可配置属性(截止时间、有效期)的事件数量
+#endif
+#ifndef EBUS_GROUP_NUM
+#define EBUS_GROUP_NUM              (4)     //组播组数量，不超过256，组句柄低8位为组表序号
+#endif
+#ifndef EBUS_GROUP_MAX_MEMBER
+#define EBUS_GROUP_MAX_MEMBER       (16)    //单个组播组的最大成员数量
+#endif
+#ifndef EBUS_NODE_FILTER_NUM
+#define EBUS_NODE_FILTER_NUM        (4)     //单个节点的内容过滤条件数量
+#endif
+#ifndef EBUS_GATHER_NUM
+#define EBUS_GATHER_NUM             (2)     //同时进行的汇聚指示数量
+#endif
+#ifndef EBUS_GATHER_MAX_DST
+#define EBUS_GATHER_MAX_DST         (8)     //单个汇聚指示的最大目标数量，不超过32
+#endif
+#ifndef EBUS_RETRY_NUM
+#define EBUS_RETRY_NUM              (4)     //同时进行的可重传指示数量
+#endif
+#ifndef EBUS_RETRY_MAX_INTERVAL_MS
+#define EBUS_RETRY_MAX_INTERVAL_MS  (1000)  //重传退避间隔上限
+#endif
+#ifndef EBUS_DEDUP_WINDOW
+#define EBUS_DEDUP_WINDOW           (4)     //节点为每个请求方记录的最近可重传指示数量，用于重复抑制，不小于EBUS_RETRY_NUM时在途指示不会被挤出
+#endif
+#ifndef EBUS_DEDUP_SRC_NUM
+#define EBUS_DEDUP_SRC_NUM          (4)     //节点同时记录重复抑制窗口的请求方数量，超出时替换最久未用的请求方，为0时不保存窗口
+#endif
+#ifndef EBUS_TIMER_NUM
+#define EBUS_TIMER_NUM              (16)    //延时/周期发布的定时项数量，不超过255
+#endif
+#ifndef EBUS_TIMER_WHEEL_BITS
+#define EBUS_TIMER_WHEEL_BITS       (5)     //时间轮每级槽位数为2的该次幂
+#endif
+#define EBUS_TIMER_WHEEL_LEVEL      (3)     //时间轮级数，覆盖2^(BITS*LEVEL)个tick，更远的定时项在溢出链表中等待
+#ifdef RT_USING_SMP
+#define EBUS_CACHE_LINE_SIZE        (64)    //缓存行大小，节点内各线程分别写入的字段按缓存行隔开
+#else
+#define EBUS_CACHE_LINE_SIZE        (RT_ALIGN_SIZE) //单核不存在伪共享，不额外占用内存
+#endif
+#ifdef RT_USING_SMP
+#define EBUS_CPU_NUM                (RT_CPUS_NR)    //注册表读者计数等按核分片的数量
+#else
+#define EBUS_CPU_NUM                (1)
+#endif
+
+#define EBUS_NODE_IDX_BROADCAST     (0xFFFF)                                //广播目标句柄
+#define EBUS_NODE_SLOT_MASK         ((1U << EBUS_NODE_SLOT_BITS) - 1)       //槽位索引掩码
+#define EBUS_NODE_GEN_MASK          (0xFFFFU >> EBUS_NODE_SLOT_BITS)        //代数掩码
+#define EBUS_NODE_MAX_SLOT_NUM      (EBUS_NODE_SLOT_MASK)                   //槽位上限，全1保留给广播
+#define EBUS_NODE_SLOT_NONE         (0xFFFF)                                //空槽位链接
+#define EBUS_CPU_ANY                (0xFF)                                  //节点不指定所属核
+
+#define EBUS_TIMER_HANDLE_NONE      (0xFFFF)                                //无效的定时发布句柄
+#define EBUS_TIMER_WHEEL_SIZE       (1U << EBUS_TIMER_WHEEL_BITS)           //时间轮每级槽位数
+#define EBUS_DEDUP_ENABLE           (EBUS_DEDUP_SRC_NUM > 0 && EBUS_DEDUP_WINDOW > 0)   //是否保存重复抑制窗口
+
+#define EBUS_NODE_FLAG_STATIC       (0x01)  //节点存储由调用者提供，销毁时不释放
+#define EBUS_NODE_FLAG_DIRECT       (0x02)  //同线程发送的通知直接调用本节点回调
+
+#define EBUS_MSG_FLAG_RETRY         (0x01)  //可重传指示及其响应，接收方按(源句柄,序列号)抑制重复
+#define EBUS_MSG_FLAG_REMOTE        (0x02)  //由传输端口从总线外注入，端口节点不再向外转发
+#define EBUS_MSG_FLAG_MASK          (0x0F)  //消息标志与类型共用一个字节，只有低4位
+
+#define EBUS_MSG_HEAD_VERSION       (2)     //消息头布局版本，经共享内存等按原样交换消息的两端须一致
+
+#define EBUS_NODE_IDX_MAKE(slot, gen)   ((uint16_t)((((gen) & EBUS_NODE_GEN_MASK) << EBUS_NODE_SLOT_BITS) | ((slot) & EBUS_NODE_SLOT_MASK)))
+#define EBUS_NODE_IDX_SLOT(idx)         ((uint16_t)((idx) & EBUS_NODE_SLOT_MASK))
+#define EBUS_NODE_IDX_GEN(idx)          ((uint16_t)(((idx) >> EBUS_NODE_SLOT_BITS) & EBUS_NODE_GEN_MASK))
+
+// 组播消息的dst_node_idx为组句柄：低8位为组表序号，高8位为组表项的代次
+#define EBUS_GROUP_IDX_MAKE(slot, gen)  ((uint16_t)((((uint16_t)(gen) & 0xFF) << 8) | ((slot) & 0xFF)))
+#define EBUS_GROUP_IDX_SLOT(idx)        ((uint16_t)((idx) & 0xFF))
+#define EBUS_GROUP_IDX_GEN(idx)         ((uint8_t)(((idx) >> 8) & 0xFF))
 
 /*** 
  * @description: 指示消息状态
@@ -34,8 +148,21 @@ typedef enum eEbusRstTag
     eEbusRst_NodeNotFound,
     eEbusRst_OtherEvt,
     eEbusRst_QueueFull,
+    eEbusRst_NameCollision,
+    eEbusRst_RateLimited,
+    eEbusRst_NoCredit,
 } eEbusRst_t;
 
+/**
+ * @description: 令牌不足时的限流策略
+ */
+typedef enum eEbusRatePolicyTag
+{
+    eEbusRatePolicy_Reject = 0,             //返回eEbusRst_RateLimited
+    eEbusRatePolicy_Drop,                   //丢弃消息并返回成功，指示按拒绝处理
+    eEbusRatePolicy_Delay,                  //阻塞发送线程直到有令牌，中断中按拒绝处理
+} eEbusRatePolicy_t;
+
 /**
  * @description: 消息类型
  * @return {*}
@@ -46,6 +173,7 @@ typedef enum eEbusMsgTypeTag
     eEbusMsgType_Notification,              //通知 无应答
     eEbusMsgType_Indication,                //指示 需应答
     eEbusMsgType_Response,                  //响应
+    eEbusMsgType_Multicast,                 //组播 dst_node_idx为组序号
 } eEbusMsgType_t;
 
 /*** 
@@ -57,11 +185,33 @@ typedef enum eEbusEvtTypeTag
     eEbusEvtType_RecvCb = 0,                //接收回调
     eEBusEvtType_IndicationCb,              //接收指示回调
     eEBusEvtType_IndicationAckCb,           //指示应答回调
+    eEBusEvtType_IndicationTimeoutCb,       //指示应答超时回调
 } eEbusEvtType_t;
 
+/**
+ * @description: 节点名称ID，与运行期对名称计算的散列值一致：sum(name[i] * 0x01000193^i)
+ *               参数须为字符串字面量，开启优化时编译器将其折叠为常量，发送时无需任何字符串操作
+ *               名称超过31字节的部分不参与计算，与节点名称截断规则一致
+ */
+#define EBUS_NAME_TERM(s, i, k)     ((uint32_t)((i) < sizeof(s) ? (uint8_t)(s)[(i) < sizeof(s) ? (i) : 0] : 0) * (k))
+#define EBUS_NODE_ID(s)                                                                                        \
+    (EBUS_NAME_TERM(s, 0, 0x00000001U) + EBUS_NAME_TERM(s, 1, 0x01000193U) + EBUS_NAME_TERM(s, 2, 0x26027A69U) + \
+     EBUS_NAME_TERM(s, 3, 0x3EE6B34BU) + EBUS_NAME_TERM(s, 4, 0x502C3F11U) + EBUS_NAME_TERM(s, 5, 0x46A747C3U) + \
+     EBUS_NAME_TERM(s, 6, 0xFC55F7F9U) + EBUS_NAME_TERM(s, 7, 0x34555CFBU) + EBUS_NAME_TERM(s, 8, 0x5D615F21U) + \
+     EBUS_NAME_TERM(s, 9, 0x2148C0F3U) + EBUS_NAME_TERM(s, 10, 0x5887BE89U) + EBUS_NAME_TERM(s, 11, 0xE6B0F1ABU) + \
+     EBUS_NAME_TERM(s, 12, 0xD38C7031U) + EBUS_NAME_TERM(s, 13, 0x37149D23U) + EBUS_NAME_TERM(s, 14, 0xD8735E19U) + \
+     EBUS_NAME_TERM(s, 15, 0xD69D215BU) + EBUS_NAME_TERM(s, 16, 0x345B8241U) + EBUS_NAME_TERM(s, 17, 0xAD0E0C53U) + \
+     EBUS_NAME_TERM(s, 18, 0xC01D66A9U) + EBUS_NAME_TERM(s, 19, 0x17489C0BU) + EBUS_NAME_TERM(s, 20, 0xB24DA551U) + \
+     EBUS_NAME_TERM(s, 21, 0x013B3E83U) + EBUS_NAME_TERM(s, 22, 0x73436839U) + EBUS_NAME_TERM(s, 23, 0xAC1D11BBU) + \
+     EBUS_NAME_TERM(s, 24, 0xACC2E961U) + EBUS_NAME_TERM(s, 25, 0x57D563B3U) + EBUS_NAME_TERM(s, 26, 0xF7EBF2C9U) + \
+     EBUS_NAME_TERM(s, 27, 0x116F326BU) + EBUS_NAME_TERM(s, 28, 0xDD0C5E71U) + EBUS_NAME_TERM(s, 29, 0x6B78ABE3U) + \
+     EBUS_NAME_TERM(s, 30, 0x11F69659U))
+
 typedef struct sEbusNodeTag sEbusNode_t;
 typedef struct sEbusMsgItemTag sEbusMsgItem_t;
 typedef void (*EbusCbPtr)(eEbusEvtType_t evt, sEbusNode_t *node, sEbusMsgItem_t *msg, void *user_data);
+typedef rt_bool_t (*EbusFilterPtr)(const sEbusNode_t *node, const sEbusMsgItem_t *msg, void *user_data);
+typedef rt_err_t (*EbusPortPtr)(sEbusNode_t *node, uint32_t src_node_id, const sEbusMsgItem_t *msg, void *port_arg);
 
 /**
  * @description: 总线消息信息
@@ -69,14 +219,17 @@ typedef void (*EbusCbPtr)(eEbusEvtType_t evt, sEbusNode_t *node, sEbusMsgItem_t
  */
 struct sEbusMsgItemTag
 {
-    eEbusMsgType_t type;                   //消息类型
-    uint8_t src_node_idx;           //事件源id
-    uint8_t dst_node_idx;           //事件目标id
-    rt_tick_t timestamp;              //时间戳
-    uint16_t seq_num;                //序列号
-    uint16_t evt_id;                 //事件id
+    rt_tick_t timestamp;            //时间戳
+    uint32_t seq_num;               //序列号，每个源节点独立分配
+    uint16_t src_node_idx;          //事件源句柄
+    uint16_t dst_node_idx;          //事件目标句柄
+    uint16_t evt_id;                //事件id
+    uint16_t deadline;              //相对时间戳的处理截止时间(tick)，0表示按事件属性
+    uint16_t ttl;                   //相对时间戳的有效期(tick)，过期的广播/通知出队时丢弃，0表示按事件属性
+    uint8_t type : 4;               //消息类型 eEbusMsgType_t
+    uint8_t flag : 4;               //消息标志 EBUS_MSG_FLAG_xxx，由发送接口填写
     uint8_t len;                    //数据长度
-    uint8_t data[EBUS_MAX_MSG_SIZE];//数据指针
+    uint8_t data[EBUS_MAX_MSG_SIZE];//数据
 };
 
 /**
@@ -84,47 +237,447 @@ struct sEbusMsgItemTag
  */
 typedef struct sEbusWaitRespTag
 {
-    uint16_t seq_num;        // 序列号
-    uint8_t src_node_idx;   // 源节点ID
-    uint8_t dst_node_idx;   // 目标节点ID
+    uint32_t seq_num;        // 序列号
+    uint16_t src_node_idx;  // 源节点句柄
+    uint16_t dst_node_idx;  // 目标节点句柄
     rt_tick_t send_time;      // 发送时间
+    rt_tick_t timeout;        // 应答超时时长，0表示不超时
+    void *ctx;                // 发送者上下文，作为应答/超时回调的user_data返回
+    uint8_t credit;           // 是否占用了目标节点的信用，释放等待项时归还
+    uint8_t gather;           // 所属汇聚指示序号+1，0表示普通指示
+    uint8_t retry;            // 重传表项序号+1，0表示不重传
     eEbusMsgState_t state;          // 状态
 } sEbusWaitResp_t;
 
+/**
+ * @description: 令牌桶，令牌按 rate 条/秒 补充，最多积累 burst 条
+ */
+typedef struct sEbusRateTag
+{
+    uint16_t rate;                  //每秒允许的消息数，0表示不限流
+    uint16_t burst;                 //桶容量，允许的突发消息数
+    uint8_t policy;                 //令牌不足时的策略 eEbusRatePolicy_t
+    rt_tick_t last;                 //上次补充令牌的时刻
+    uint32_t tokens;                //令牌数 × RT_TICK_PER_SECOND
+    uint32_t limited_cnt;           //被拒绝、丢弃或延迟的消息数量
+    struct rt_spinlock lock;        //本桶的锁，同时取两个桶时先锁节点桶再锁事件桶
+} sEbusRate_t;
+
+/**
+ * @description: 节点容量配置，0表示使用默认值
+ */
+typedef struct sEbusNodeCfgTag
+{
+    uint16_t msg_num;               //消息队列深度
+    uint8_t msg_size;               //可接收的最大消息长度，不超过EBUS_MAX_MSG_SIZE
+    uint16_t resp_wait_num;         //等待响应槽位数量
+} sEbusNodeCfg_t;
+
+/**
+ * @description: 节点容量统计，用于容量评估
+ */
+typedef struct sEbusNodeStatTag
+{
+    uint16_t msg_hwm;               //消息队列最高水位
+    uint16_t resp_wait_hwm;         //等待响应槽位最高水位
+    uint8_t msg_len_hwm;            //收到的最大消息长度
+    uint32_t queue_full_cnt;        //队列满丢弃次数
+    uint32_t resp_full_cnt;         //等待槽位不足次数
+    uint32_t deadline_miss_cnt;     //超过截止时间才取出的消息数量
+    uint32_t expired_cnt;           //超过有效期被丢弃的消息数量
+    uint32_t filtered_cnt;          //未通过内容过滤、在发送端丢弃的消息数量
+    uint32_t retry_cnt;             //本节点重传指示的次数
+    uint32_t dup_cnt;               //抑制的重复指示数量
+} sEbusNodeStat_t;
+
+#if EBUS_DEDUP_ENABLE
+/**
+ * @description: 重复抑制记录，已响应时保存响应，重复的指示到达时重发响应而不再调用回调
+ */
+typedef struct sEbusDedupTag
+{
+    uint32_t seq_num;               //序列号
+    uint16_t evt_id;                //响应事件id
+    uint8_t state;                  //eEbusMsgState_Sented处理中，eEbusMsgState_Recved已响应
+    uint8_t len;                    //响应数据长度
+    uint8_t data[EBUS_MAX_MSG_SIZE];//响应数据
+} sEbusDedup_t;
+
+/**
+ * @description: 单个请求方的重复抑制窗口，各请求方互不挤占
+ */
+typedef struct sEbusDedupSrcTag
+{
+    uint8_t used;                   //是否已分配给请求方
+    uint8_t pos;                    //下一个替换的记录
+    uint16_t src_node_idx;          //请求方句柄
+    rt_tick_t last;                 //最近一次收到该请求方可重传指示的时刻
+    sEbusDedup_t entry[EBUS_DEDUP_WINDOW];
+} sEbusDedupSrc_t;
+#endif
+
+/**
+ * @description: 可重传指示，保存原始消息以便以同一序列号重发
+ */
+typedef struct sEbusRetryTag
+{
+    uint8_t used;                   //是否已分配
+    uint8_t retry_left;             //剩余重传次数
+    sEbusMsgItem_t msg;             //原始指示
+} sEbusRetry_t;
+
+/**
+ * @description: 内容过滤条件，取data[offset]起len字节按小端拼成整数，(值 & mask) == value 时通过
+ */
+typedef struct sEbusFilterTag
+{
+    uint16_t evt_id;                //过滤的事件id
+    uint8_t offset;                 //比较的起始字节
+    uint8_t len;                    //比较的字节数 1~4
+    uint32_t mask;                  //掩码
+    uint32_t value;                 //期望值
+} sEbusFilter_t;
+
 /**
  * @description: 总线节点数据
  */
 struct sEbusNodeTag
 {
+    /* 创建后基本不变，发送方查找、投递时只读 */
     uint8_t init;                   //是否初始化
-    char name[EBUS_NAME_LEN];    //总线名称
-    uint8_t node_idx;               //总线id
+    uint8_t flag;                   //节点标志 EBUS_NODE_FLAG_xxx
+    uint8_t msg_size;               //本节点可接收的最大消息长度
+    uint8_t filter_num;             //内容过滤条件数量
+    uint16_t node_idx;              //节点句柄(代数+槽位)
+    uint16_t hash_next;             //名称散列链中下一个槽位
+    uint32_t name_hash;             //名称散列值，即节点名称ID EBUS_NODE_ID(name)
+    uint16_t wait_resp_num;         //等待响应槽位数量
+    uint16_t credit_max;            //接受的未完成指示数量，0表示不做信用流控
+    uint8_t exec_attached;          //回调由执行器线程池执行
+    uint8_t home_cpu;               //所属核，执行器只在该核的工作线程上执行本节点，EBUS_CPU_ANY表示不指定
     rt_mq_t msg_queue;              //消息队列
     EbusCbPtr Evtcb;                  //回调接口
-    sEbusWaitResp_t wait_resp_list[EBUS_NODE_MAX_RESP_WAIT_NUM];
+    sEbusWaitResp_t *wait_resp_list;   //等待响应列表，存储位于节点缓冲区
     rt_mutex_t resp_mutex;             //响应管理互斥锁
+    EbusFilterPtr filter_fn;        //自定义过滤函数，在发送端上下文调用
+    void *filter_arg;               //自定义过滤函数参数
+    EbusPortPtr port;               //传输端口，设置后发给本节点的消息交给端口转发，不进入消息队列
+    void *port_arg;                 //传输端口参数
+    sEbusFilter_t filter[EBUS_NODE_FILTER_NUM];   //内容过滤条件，受注册表读写锁保护
+    char name[EBUS_NAME_LEN];    //总线名称
+
+    /* 发送方写入：其他线程向本节点投递、调度执行器时修改 */
+    rt_align(EBUS_CACHE_LINE_SIZE) volatile rt_atomic_t credit;    //剩余信用
+    volatile rt_atomic_t exec_state;    //执行器调度状态
+    volatile rt_atomic_t direct_ref;    //正在直接回调本节点的发送方数量，销毁时在direct_sem上等待归零
+    uint8_t exec_urgent;            //队列中有带截止时间的消息，按exec_deadline排序
+    uint8_t exec_linked;            //位于某个工作线程的就绪队列中
+    uint8_t exec_worker;            //所在或上次执行的工作线程
+    rt_tick_t exec_deadline;        //队列中消息的最早截止时刻
+    sEbusNode_t *exec_prev;         //就绪队列链接
+    sEbusNode_t *exec_next;
+
+    /* 所属线程写入：接收、直接投递，以及本节点作为发送源 */
+    rt_align(EBUS_CACHE_LINE_SIZE) volatile rt_atomic_t tx_sn;     //本节点作为发送源的序列号，与其他节点互不影响
+    rt_thread_t direct_owner;       //直接投递时节点所属线程
+    uint8_t direct_depth;           //直接投递调用链中的深度，0表示不在直接回调中
+    uint8_t recv_busy;              //所属线程正在处理从队列取出的消息
+    sEbusRate_t rate;               //本节点作为发送源的令牌桶
+
+    /* 容量统计：发送方入队时读取水位、更新水位与丢弃计数，与所属线程的字段分开 */
+    rt_align(EBUS_CACHE_LINE_SIZE) sEbusNodeStat_t stat;
+
+    /* 等待响应状态：受resp_mutex保护，请求方与应答方线程都会修改 */
+    rt_align(EBUS_CACHE_LINE_SIZE) uint16_t wait_resp_used;        //已占用的等待响应槽位
+    uint16_t wait_resp_timed;       //设置了超时的等待响应数量
+    rt_tick_t resp_deadline;        //最早的应答超时时刻
+#if EBUS_DEDUP_ENABLE
+    sEbusDedupSrc_t dedup[EBUS_DEDUP_SRC_NUM];  //按请求方记录的最近可重传指示，受resp_mutex保护
+#endif
+    struct rt_mutex resp_mutex_obj;         //响应互斥锁对象
+
+    /* 消息队列对象，发送方与接收方共同修改 */
+    rt_align(EBUS_CACHE_LINE_SIZE) struct rt_messagequeue msg_queue_obj;   //消息队列对象
+};
+
+/* 消息头长度及携带len字节数据时的消息长度，队列按实际长度拷贝；字段按宽度排列，消息头无填充 */
+#define EBUS_MSG_HEAD_SIZE              offsetof(sEbusMsgItem_t, data)
+#define EBUS_MSG_ITEM_SIZE(len)         (EBUS_MSG_HEAD_SIZE + (len))
+
+/* 类型与标志为位域，不能取地址；需要枚举类型时(如switch、格式化输出)经访问宏取值 */
+#define EBUS_MSG_TYPE(msg)              ((eEbusMsgType_t)(msg)->type)
+#define EBUS_MSG_FLAG(msg)              ((uint8_t)(msg)->flag)
+
+/* 节点缓冲区大小：消息队列缓冲区 + 等待响应列表，两者各自从缓存行起始 */
+#define EBUS_NODE_MQ_POOL_SIZE(msg_num, msg_size)                           \
+    RT_ALIGN(RT_MQ_BUF_SIZE(EBUS_MSG_ITEM_SIZE(msg_size), (msg_num)), EBUS_CACHE_LINE_SIZE)
+#define EBUS_NODE_STORAGE_SIZE(msg_num, msg_size, resp_num)                 \
+    (EBUS_NODE_MQ_POOL_SIZE(msg_num, msg_size) +                           \
+     RT_ALIGN(sizeof(sEbusWaitResp_t) * (resp_num), EBUS_CACHE_LINE_SIZE))
+#define EBUS_NODE_POOL_SIZE             EBUS_NODE_STORAGE_SIZE(EBUS_MAX_MSG_NUM, EBUS_MAX_MSG_SIZE, EBUS_NODE_MAX_RESP_WAIT_NUM)
+
+/**
+ * @description: 静态节点存储，节点与缓冲区连续布局
+ */
+typedef struct sEbusNodeStaticTag
+{
+    sEbusNode_t node;
+    rt_align(EBUS_CACHE_LINE_SIZE) rt_uint8_t pool[EBUS_NODE_POOL_SIZE];
+} sEbusNodeStatic_t;
+
+/* 定义单个静态节点 / 连续的静态节点表 */
+#define EBUS_NODE_STATIC_DEFINE(sym)            static sEbusNodeStatic_t sym
+#define EBUS_NODE_TABLE_DEFINE(sym, num)        static sEbusNodeStatic_t sym[num]
+/* 定义指定容量的静态节点 */
+#define EBUS_NODE_STATIC_DEFINE_EX(sym, msg_num, msg_size, resp_num)                           \
+    static struct                                                                              \
+    {                                                                                          \
+        sEbusNode_t node;                                                                      \
+        rt_align(EBUS_CACHE_LINE_SIZE) rt_uint8_t pool[EBUS_NODE_STORAGE_SIZE(msg_num, msg_size, resp_num)]; \
+    } sym
+/* 在静态存储上初始化节点 */
+#define EBUS_NODE_STATIC_INIT(st, name, cb)     EbusNodeInit(&(st)->node, (name), (cb), (st)->pool, sizeof((st)->pool))
+#define EBUS_NODE_STATIC_INIT_EX(st, name, cb, cfg) \
+    EbusNodeInitEx(&(st)->node, (name), (cb), (cfg), (st)->pool, sizeof((st)->pool))
+
+/**
+ * @description: 节点表槽位的链接，与节点指针分表存放，避免指针对齐带来的填充
+ */
+typedef struct sEbusSlotTag
+{
+    uint16_t free_next;             //空闲时为下一个空闲槽位与本槽位代数组成的句柄，代数每次复用递增
+    uint16_t hash_head;             //以本槽位为桶的名称散列链表头
+} sEbusSlot_t;
+
+/**
+ * @description: 按核分片的计数，各占一个缓存行
+ */
+typedef struct sEbusCpuCntTag
+{
+    rt_align(EBUS_CACHE_LINE_SIZE) volatile rt_atomic_t cnt;
+} sEbusCpuCnt_t;
+
+/**
+ * @description: 总线注册表读写锁，读者只在本核的计数上做原子加减，写者持有支持优先级继承的互斥量
+ */
+typedef struct sEbusRwLockTag
+{
+    volatile rt_atomic_t writer;            //写者是否占用，读者只读
+    struct rt_mutex writer_mutex;           //写者互斥量，被阻塞的读者经此向写者继承优先级
+    struct rt_semaphore drain_sem;          //写者等待读者退出
+    sEbusCpuCnt_t readers[EBUS_CPU_NUM];    //各核进入临界区的读者数量，线程迁移后可在另一核退出，写者只看总和
+} sEbusRwLock_t;
+
+/**
+ * @description: 中断发布暂存环单元
+ */
+typedef struct sEbusIsrCellTag
+{
+    volatile rt_atomic_t seq;               //单元序号，判断单元可写/可读
+    sEbusMsgItem_t msg;                     //暂存的消息
+} sEbusIsrCell_t;
+
+/**
+ * @description: 中断发布暂存环，按核分片，本核的中断只写入本核的暂存环；多生产者无锁入队，单个转发者出队
+ */
+typedef struct sEbusIsrRingTag
+{
+    rt_align(EBUS_CACHE_LINE_SIZE) volatile rt_atomic_t head;  //入队位置
+    volatile rt_atomic_t tail;              //出队位置
+    volatile rt_atomic_t draining;          //是否有上下文正在转发
+    volatile rt_atomic_t drop_cnt;          //暂存环满丢弃的消息数量
+    sEbusIsrCell_t cell[EBUS_ISR_RING_SIZE];
+} sEbusIsrRing_t;
+
+/**
+ * @description: 执行器工作线程，就绪节点组成双端队列，本线程从队头取，其他线程从队尾窃取
+ */
+typedef struct sEbusExecWorkerTag
+{
+    struct rt_spinlock lock;                //就绪队列锁，可在中断中入队
+    sEbusNode_t *head;                      //队头
+    sEbusNode_t *tail;                      //队尾
+    rt_thread_t thread;                     //工作线程
+    struct rt_semaphore sem;                //本线程就绪节点计数，空闲时在此等待
+    volatile rt_atomic_t current;           //正在执行的节点，退出执行器时等待工作线程不再访问该节点
+    uint8_t id;                             //工作线程编号
+    uint8_t cpu;                            //绑定的核
+    uint32_t run_cnt;                       //执行节点的次数
+    uint32_t steal_cnt;                     //从其他工作线程窃取的次数
+} sEbusExecWorker_t;
+
+/**
+ * @description: 节点回调执行器，每个节点同一时刻只在一个工作线程上执行，保持节点内消息顺序
+ */
+typedef struct sEbusExecTag
+{
+    uint8_t init;                           //是否初始化
+    uint8_t worker_num;                     //工作线程数量
+    volatile rt_atomic_t running;           //工作线程是否运行
+    volatile rt_atomic_t next_worker;       //新就绪节点轮流分配的工作线程
+    volatile rt_atomic_t urgent_num;        //就绪队列中带截止时间的节点数量
+    volatile rt_atomic_t idle_mask;         //正在等待的工作线程，新就绪节点所在线程忙时唤醒其中一个窃取
+    struct rt_semaphore exit_sem;           //工作线程退出通知
+    volatile rt_atomic_t detach_wait;       //等待节点离开工作线程的EbusExecDetach调用者数量
+    struct rt_semaphore detach_sem;         //节点离开工作线程的通知，有等待者时释放
+    sEbusExecWorker_t worker[EBUS_EXEC_MAX_WORKER];
+} sEbusExec_t;
+
+/**
+ * @description: 事件属性，发送时填充消息中未指定的字段
+ */
+typedef struct sEbusEvtAttrTag
+{
+    uint16_t evt_id;                        //事件id
+    uint16_t deadline;                      //相对截止时间(tick)
+    uint16_t ttl;                           //有效期(tick)
+    sEbusRate_t rate;                       //该事件的令牌桶，所有发送源共用
+} sEbusEvtAttr_t;
+
+typedef struct sEbusGatherTag sEbusGather_t;
+typedef void (*EbusGatherCbPtr)(sEbusNode_t *node, eEbusRst_t rst, const sEbusGather_t *gather, void *user_data);
+
+/**
+ * @description: 汇聚指示，同一序列号发往多个目标，全部响应到达或超时时一次交付
+ */
+struct sEbusGatherTag
+{
+    uint8_t used;                           //是否已分配
+    uint8_t dst_num;                        //目标数量
+    uint32_t seq_num;                       //各目标共用的序列号
+    uint32_t sent_mask;                     //已发出指示的目标
+    uint32_t recv_mask;                     //已收到响应的目标，resp[i]有效
+    uint32_t credit_mask;                   //占用了信用的目标
+    EbusGatherCbPtr on_complete;            //完成回调，在请求方接收线程中调用
+    void *ctx;                              //完成回调的user_data
+    uint16_t dst_node_idx[EBUS_GATHER_MAX_DST];   //目标节点句柄，未找到的目标为EBUS_NODE_IDX_BROADCAST
+    sEbusMsgItem_t resp[EBUS_GATHER_MAX_DST];     //各目标的响应
+};
+
+/**
+ * @description: 组播组，成员以节点句柄记录，节点销毁时自动退出
+ */
+typedef struct sEbusGroupTag
+{
+    uint8_t used;                           //是否已创建
+    uint8_t member_num;                     //成员数量
+    uint8_t gen;                            //表项代次，删除时递增，旧的组句柄随之失效
+    uint32_t group_id;                      //组名称ID EBUS_NODE_ID(name)
+    uint16_t member[EBUS_GROUP_MAX_MEMBER]; //成员节点句柄
+} sEbusGroup_t;
+
+typedef struct sEbusTimerTag sEbusTimer_t;
+
+/**
+ * @description: 延时/周期发布的定时项，按到期时刻挂在时间轮槽位上
+ */
+struct sEbusTimerTag
+{
+    sEbusTimer_t *next;                     //同一槽位的下一项
+    sEbusTimer_t **pprev;                   //指向前一项的next或槽位表头，RT_NULL表示未挂入
+    rt_tick_t expire;                       //到期时刻
+    rt_tick_t period;                       //发布周期，0表示只发布一次
+    uint8_t used;                           //是否已分配
+    uint8_t gen;                            //代数，释放时递增，使旧句柄失效
+    sEbusNode_t *node;                      //发布源节点，节点销毁前先取消其定时项
+    sEbusMsgItem_t msg;                     //待发布的消息，src_node_idx/dst_node_idx已填写
 };
 
+/**
+ * @description: 分级时间轮，一个周期定时器驱动全部延时/周期发布，每个tick批量发布到期消息
+ */
+typedef struct sEbusTimerWheelTag
+{
+    uint8_t running;                        //驱动定时器是否运行，无定时项时停止
+    uint16_t active;                        //已分配的定时项数量
+    rt_tick_t cur;                          //时间轮已处理到的tick
+    struct rt_spinlock lock;                //时间轮锁，可在中断中使用
+    struct rt_timer timer;                  //驱动定时器，周期1个tick
+    sEbusTimer_t *wheel[EBUS_TIMER_WHEEL_LEVEL][EBUS_TIMER_WHEEL_SIZE];   //各级槽位
+    sEbusTimer_t *far;                      //超出时间轮范围的定时项
+    sEbusTimer_t pool[EBUS_TIMER_NUM];      //定时项存储
+} sEbusTimerWheel_t;
+
 /**
  * @description: 总线整体信息
  */
 typedef struct sEbusTag
 {
     uint8_t init;                           //是否初始化
-    rt_mutex_t bus_mutex;                      //总线互斥量
-    uint16_t sn;                             //总线序列号
-    uint8_t node_len;                       //总线数量
-    sEbusNode_t *node_tbl[EBUS_MAX_NODE_NUM];   //总线表
+    sEbusRwLock_t bus_lock;                 //注册表读写锁
+    uint16_t node_len;                      //总线数量
+    uint16_t slot_cap;                      //节点表容量
+    uint16_t free_head;                     //空闲槽位链表头
+    sEbusNode_t **node_tbl;                 //节点表，空闲槽位为RT_NULL，初始指向node_static，扩容后指向堆
+    sEbusSlot_t *slot_tbl;                  //槽位链接表，与node_tbl等长，扩容后与node_tbl位于同一块堆内存
+    sEbusNode_t *node_static[EBUS_MAX_NODE_NUM];  //初始节点表
+    sEbusSlot_t slot_static[EBUS_MAX_NODE_NUM];   //初始槽位链接表
+    sEbusIsrRing_t isr_ring[EBUS_CPU_NUM];  //按核分片的中断发布暂存环
+    volatile rt_atomic_t direct_wait;       //等待直接回调结束的销毁者数量
+    struct rt_semaphore direct_sem;         //直接回调结束通知，有销毁者等待时释放
+    sEbusGroup_t group[EBUS_GROUP_NUM];     //组播组表，受注册表读写锁保护
+    struct rt_spinlock gather_lock;         //汇聚指示分配锁
+    sEbusGather_t gather[EBUS_GATHER_NUM];  //汇聚指示表，分配后只由请求方接收线程访问
+    struct rt_spinlock retry_lock;          //重传表分配锁
+    sEbusRetry_t retry[EBUS_RETRY_NUM];     //重传表，由所属等待响应项引用
+    uint8_t evt_attr_num;                   //已配置属性的事件数量
+    sEbusEvtAttr_t evt_attr[EBUS_EVT_ATTR_NUM];   //事件属性表
 } sEbus_t;
 
-void EbusCreate(void);
+rt_bool_t EbusCreate(void);
 
 void EbusDestory(void);
 
 sEbusNode_t *EbusNodeCreate(char *name, EbusCbPtr EvtCb);
 
+sEbusNode_t *EbusNodeFind(const char *name);
+
+sEbusNode_t *EbusNodeCreateEx(char *name, EbusCbPtr EvtCb, const sEbusNodeCfg_t *cfg);
+
+eEbusRst_t EbusNodeInit(sEbusNode_t *node, char *name, EbusCbPtr EvtCb, void *storage, rt_size_t storage_size);
+
+eEbusRst_t EbusNodeInitEx(sEbusNode_t *node, char *name, EbusCbPtr EvtCb, const sEbusNodeCfg_t *cfg,
+                          void *storage, rt_size_t storage_size);
+
+void EbusNodeSizingHint(sEbusNode_t *node, sEbusNodeCfg_t *hint);
+
 void EbusNodeDestory(sEbusNode_t *node);
 
+void EbusNodeSetDirect(sEbusNode_t *node, rt_bool_t enable);
+
+eEbusRst_t EbusNodeSetCpu(sEbusNode_t *node, uint8_t cpu);
+
+eEbusRst_t EbusEvtDeadlineSet(uint16_t evt_id, uint16_t deadline);
+
+eEbusRst_t EbusEvtTtlSet(uint16_t evt_id, uint16_t ttl);
+
+eEbusRst_t EbusEvtRateSet(uint16_t evt_id, uint16_t rate, uint16_t burst, eEbusRatePolicy_t policy);
+
+eEbusRst_t EbusNodeRateSet(sEbusNode_t *node, uint16_t rate, uint16_t burst, eEbusRatePolicy_t policy);
+
+eEbusRst_t EbusNodeCreditSet(sEbusNode_t *node, uint16_t credit);
+
+int EbusCreditAvail(uint32_t dst_node_id);
+
+eEbusRst_t EbusNodeFilterAdd(sEbusNode_t *node, uint16_t evt_id, uint8_t offset, uint8_t len, uint32_t mask,
+                             uint32_t value);
+
+eEbusRst_t EbusNodeFilterClear(sEbusNode_t *node, uint16_t evt_id);
+
+void EbusNodeFilterSet(sEbusNode_t *node, EbusFilterPtr filter_fn, void *user_data);
+
+void EbusNodeSetPort(sEbusNode_t *node, EbusPortPtr port, void *port_arg);
+
+eEbusRst_t EbusPortInject(sEbusNode_t *node, uint32_t dst_node_id, sEbusMsgItem_t *msg);
+
+eEbusRst_t EbusExecCreate(uint8_t worker_num);
+
+void EbusExecDestory(void);
+
+eEbusRst_t EbusExecAttach(sEbusNode_t *node);
+
+void EbusExecDetach(sEbusNode_t *node);
+
 eEbusRst_t EbusMsgWaitRecv(sEbusNode_t *node, sEbusMsgItem_t *msg, uint32_t timeout);
 
 eEbusRst_t EbusMsgRecv(sEbusNode_t *node, sEbusMsgItem_t *msg);
@@ -133,8 +686,47 @@ eEbusRst_t EbusBroadcast(sEbusNode_t *node, sEbusMsgItem_t *msg);
 
 eEbusRst_t EbusNotification(sEbusNode_t *node, char *dst_node_name, sEbusMsgItem_t *msg);
 
+eEbusRst_t EbusGroupCreate(const char *name);
+
+eEbusRst_t EbusGroupDestory(uint32_t group_id);
+
+eEbusRst_t EbusGroupJoin(sEbusNode_t *node, uint32_t group_id);
+
+eEbusRst_t EbusGroupLeave(sEbusNode_t *node, uint32_t group_id);
+
+eEbusRst_t EbusMulticast(sEbusNode_t *node, uint32_t group_id, sEbusMsgItem_t *msg);
+
 eEbusRst_t EbusIndicationAsync(sEbusNode_t *node, char *dst_node_name, sEbusMsgItem_t *msg);
 
+eEbusRst_t EbusNotificationById(sEbusNode_t *node, uint32_t dst_node_id, sEbusMsgItem_t *msg);
+
+eEbusRst_t EbusIndicationAsyncById(sEbusNode_t *node, uint32_t dst_node_id, sEbusMsgItem_t *msg);
+
+eEbusRst_t EbusIndicationAsyncEx(sEbusNode_t *node, uint32_t dst_node_id, sEbusMsgItem_t *msg,
+                                 void *ctx, rt_tick_t timeout);
+
+eEbusRst_t EbusIndicationReliable(sEbusNode_t *node, uint32_t dst_node_id, sEbusMsgItem_t *msg, void *ctx,
+                                  rt_tick_t timeout, uint8_t retry_num);
+
+eEbusRst_t EbusIndicationGather(sEbusNode_t *node, const uint32_t *dst_node_id, uint8_t dst_num, sEbusMsgItem_t *msg,
+                                rt_tick_t timeout, EbusGatherCbPtr on_complete, void *ctx);
+
+void EbusWaitRespExpire(sEbusNode_t *node);
+
+eEbusRst_t EbusPublishFromISR(sEbusNode_t *node, uint16_t dst_node_idx, sEbusMsgItem_t *msg);
+
+eEbusRst_t EbusPublishAfter(sEbusNode_t *node, uint16_t dst_node_idx, sEbusMsgItem_t *msg, rt_tick_t delay,
+                            uint16_t *handle);
+
+eEbusRst_t EbusPublishEvery(sEbusNode_t *node, uint16_t dst_node_idx, sEbusMsgItem_t *msg, rt_tick_t period,
+                            uint16_t *handle);
+
+eEbusRst_t EbusPublishCancel(uint16_t handle);
+
 eEbusRst_t EbusResponse(sEbusNode_t *node, sEbusNode_t *ack_node, sEbusMsgItem_t *msg);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
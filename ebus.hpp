@@ -0,0 +1,533 @@
+#ifndef _EBUS_HPP_
+#define _EBUS_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "ebus.h"
+
+#if __cplusplus < 201703L
+#error "ebus.hpp requires C++17"
+#endif
+
+/* C++20协程支持 */
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#include <coroutine>
+#define EBUS_HPP_COROUTINE 1
+#else
+#define EBUS_HPP_COROUTINE 0
+#endif
+
+/* 订阅处理函数可捕获的最大字节数，处理函数就地保存，不使用堆 */
+#ifndef EBUS_HPP_HANDLER_SIZE
+#define EBUS_HPP_HANDLER_SIZE (2 * sizeof(void *))
+#endif
+
+namespace ebus
+{
+
+/**
+ * @description: 事件描述，将evt_id与负载类型绑定，负载须可按字节拷贝且不超过EBUS_MAX_MSG_SIZE
+ */
+template <uint16_t Id, typename T>
+struct Evt
+{
+    static constexpr uint16_t id = Id;
+    typedef T type;
+
+    static_assert(std::is_trivially_copyable<T>::value, "ebus payload must be trivially copyable");
+    static_assert(sizeof(T) <= EBUS_MAX_MSG_SIZE, "ebus payload exceeds EBUS_MAX_MSG_SIZE");
+};
+
+namespace detail
+{
+
+template <typename T, typename... Evts>
+constexpr std::size_t TypeCount()
+{
+    return (std::size_t(0) + ... + std::size_t(std::is_same<T, typename Evts::type>::value));
+}
+
+template <typename... Evts>
+constexpr std::size_t IdCount(uint16_t id)
+{
+    return (std::size_t(0) + ... + std::size_t(Evts::id == id));
+}
+
+} // namespace detail
+
+/**
+ * @description: 编译期事件表，evt_id与负载类型一一对应
+ */
+template <typename... Evts>
+struct EvtTable
+{
+    static constexpr std::size_t size = sizeof...(Evts);
+
+    static_assert(size > 0, "ebus event table is empty");
+    static_assert(((detail::IdCount<Evts...>(Evts::id) == 1) && ...), "duplicate evt_id in ebus event table");
+    static_assert(((detail::TypeCount<typename Evts::type, Evts...>() == 1) && ...),
+                  "payload type bound to more than one evt_id");
+
+    /* 负载类型在表中的位置，不在表中时等于size */
+    template <typename T>
+    static constexpr std::size_t IndexOf()
+    {
+        constexpr bool match[] = {std::is_same<T, typename Evts::type>::value...};
+        std::size_t i = 0;
+        while (i < size && !match[i])
+        {
+            i++;
+        }
+        return i;
+    }
+
+    /* evt_id在表中的位置，不在表中时返回-1 */
+    static constexpr int IndexOfId(uint16_t id)
+    {
+        constexpr uint16_t ids[] = {Evts::id...};
+        for (std::size_t i = 0; i < size; i++)
+        {
+            if (ids[i] == id)
+            {
+                return (int)i;
+            }
+        }
+        return -1;
+    }
+
+    template <typename T>
+    static constexpr uint16_t IdOf()
+    {
+        static_assert(IndexOf<T>() < size, "payload type not in ebus event table");
+        constexpr uint16_t ids[] = {Evts::id...};
+        return ids[IndexOf<T>()];
+    }
+};
+
+/**
+ * @description: 总线RAII封装，只销毁由本对象创建的总线
+ */
+class Bus
+{
+public:
+    Bus() : owned_(EbusCreate()) {}
+    ~Bus()
+    {
+        if (owned_)
+        {
+            EbusDestory();
+        }
+    }
+
+    Bus(const Bus &) = delete;
+    Bus &operator=(const Bus &) = delete;
+
+    bool owned() const { return owned_; }
+
+private:
+    bool owned_;
+};
+
+/**
+ * @description: 就地保存的订阅处理函数，按负载类型生成的跳板函数完成解包
+ */
+class Handler
+{
+public:
+    template <typename T, typename F>
+    void Bind(F &&fn)
+    {
+        typedef typename std::decay<F>::type Fn;
+        static_assert(sizeof(Fn) <= EBUS_HPP_HANDLER_SIZE, "handler captures exceed EBUS_HPP_HANDLER_SIZE");
+        static_assert(alignof(Fn) <= alignof(void *), "handler alignment exceeds pointer alignment");
+        static_assert(std::is_trivially_destructible<Fn>::value, "handler must be trivially destructible");
+        static_assert(std::is_invocable<Fn &, const T &>::value ||
+                          std::is_invocable<Fn &, const T &, const sEbusMsgItem_t &>::value,
+                      "handler must accept (const T &) or (const T &, const sEbusMsgItem_t &)");
+
+        ::new (static_cast<void *>(buf_)) Fn(std::forward<F>(fn));
+        thunk_ = &Invoke<T, Fn>;
+    }
+
+    bool Call(const sEbusMsgItem_t &msg)
+    {
+        return (thunk_ != nullptr) && thunk_(buf_, msg);
+    }
+
+private:
+    typedef bool (*Thunk)(void *fn, const sEbusMsgItem_t &msg);
+
+    template <typename T, typename Fn>
+    static bool Invoke(void *fn, const sEbusMsgItem_t &msg)
+    {
+        if (msg.len != sizeof(T))
+        {
+            return false;
+        }
+        // data不保证按T对齐，拷贝到对齐缓冲区后再访问，编译器会将其优化为直接加载
+        alignas(T) unsigned char raw[sizeof(T)];
+        std::memcpy(raw, msg.data, sizeof(T));
+        const T &v = *std::launder(reinterpret_cast<const T *>(raw));
+
+        Fn &f = *static_cast<Fn *>(fn);
+        if constexpr (std::is_invocable<Fn &, const T &, const sEbusMsgItem_t &>::value)
+        {
+            f(v, msg);
+        }
+        else
+        {
+            f(v);
+        }
+        return true;
+    }
+
+    alignas(void *) unsigned char buf_[EBUS_HPP_HANDLER_SIZE];
+    Thunk thunk_ = nullptr;
+};
+
+#if EBUS_HPP_COROUTINE
+/**
+ * @description: 挂起在请求上的协程，地址作为等待响应项的上下文登记到C接口
+ */
+struct Pending
+{
+    std::coroutine_handle<> handle;
+    Pending *next;
+    eEbusRst_t rst;
+    sEbusMsgItem_t msg;
+};
+
+/**
+ * @description: 请求结果，rst为eEbusRst_Success时value有效
+ */
+template <typename R>
+struct Reply
+{
+    eEbusRst_t rst;     //成功、超时、应答类型不符(eEbusRst_OtherEvt)或发送失败原因
+    R value;
+
+    explicit operator bool() const { return rst == eEbusRst_Success; }
+};
+
+/**
+ * @description: co_await node.request<R>(dst_id, req, timeout) 的等待体
+ */
+template <typename Table, typename R>
+class Request
+{
+public:
+    Request(sEbusNode_t *node, uint32_t dst_id, const sEbusMsgItem_t &msg, rt_tick_t timeout)
+        : node_(node), dst_id_(dst_id), timeout_(timeout), msg_(msg)
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        pending_.handle = handle;
+        pending_.next = nullptr;
+        // 发送成功后协程可能已在分发线程上恢复，之后不能再访问协程帧
+        eEbusRst_t rst = EbusIndicationAsyncEx(node_, dst_id_, &msg_, &pending_, timeout_);
+        if (rst != eEbusRst_Success)
+        {
+            pending_.rst = rst;
+            return false;
+        }
+        return true;
+    }
+
+    Reply<R> await_resume() const noexcept
+    {
+        Reply<R> reply{pending_.rst, {}};
+        if (reply.rst == eEbusRst_Success)
+        {
+            if (pending_.msg.evt_id != Table::template IdOf<R>() || pending_.msg.len != sizeof(R))
+            {
+                reply.rst = eEbusRst_OtherEvt;
+            }
+            else
+            {
+                std::memcpy(&reply.value, pending_.msg.data, sizeof(R));
+            }
+        }
+        return reply;
+    }
+
+private:
+    sEbusNode_t *node_;
+    uint32_t dst_id_;
+    rt_tick_t timeout_;
+    sEbusMsgItem_t msg_;
+    Pending pending_;
+};
+
+/**
+ * @description: 立即运行、结束后自行销毁的协程类型，协程帧从rt_malloc分配，分配失败时协程不运行
+ */
+struct Task
+{
+    struct promise_type
+    {
+        static void *operator new(std::size_t size) noexcept { return rt_malloc(size); }
+        static void operator delete(void *ptr) noexcept { rt_free(ptr); }
+        static Task get_return_object_on_allocation_failure() noexcept { return Task(); }
+
+        Task get_return_object() noexcept { return Task(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { RT_ASSERT(0); }
+    };
+};
+#endif
+
+/**
+ * @description: 类型化节点，节点与缓冲区位于对象内部，不使用堆；注册后对象不可移动
+ * @tparam Table 本节点使用的事件表 EvtTable<...>
+ * @tparam MsgNum 消息队列深度
+ * @tparam MsgSize 可接收的最大消息长度
+ * @tparam RespNum 等待响应槽位数量
+ */
+template <typename Table,
+          uint16_t MsgNum = EBUS_MAX_MSG_NUM,
+          uint8_t MsgSize = EBUS_MAX_MSG_SIZE,
+          uint16_t RespNum = EBUS_NODE_MAX_RESP_WAIT_NUM>
+class Node
+{
+    static_assert(MsgSize <= EBUS_MAX_MSG_SIZE, "MsgSize exceeds EBUS_MAX_MSG_SIZE");
+
+public:
+    explicit Node(const char *name)
+    {
+        sEbusNodeCfg_t cfg;
+        cfg.msg_num = MsgNum;
+        cfg.msg_size = MsgSize;
+        cfg.resp_wait_num = RespNum;
+        rst_ = EbusNodeInitEx(&node_, const_cast<char *>(name), &Node::Trampoline, &cfg, pool_, sizeof(pool_));
+    }
+
+    ~Node()
+    {
+        if (rst_ == eEbusRst_Success)
+        {
+            EbusNodeDestory(&node_);
+        }
+#if EBUS_HPP_COROUTINE
+        // 销毁时未完成的请求以超时交付，恢复挂起的协程使其结束并释放协程帧
+        ResumeReady();
+#endif
+    }
+
+    Node(const Node &) = delete;
+    Node &operator=(const Node &) = delete;
+
+    /* 注册结果，eEbusRst_Success以外的值表示节点不可用 */
+    eEbusRst_t status() const { return rst_; }
+    sEbusNode_t *native() { return &node_; }
+    uint16_t handle() const { return node_.node_idx; }
+
+    /* 直接投递，同线程发来的通知在发送接口内分发，需在处理poll()的线程中调用 */
+    void direct(bool enable) { EbusNodeSetDirect(&node_, enable ? RT_TRUE : RT_FALSE); }
+
+    /* 所属核，挂接执行器时只在该核的工作线程上执行 */
+    eEbusRst_t cpu(uint8_t cpu) { return EbusNodeSetCpu(&node_, cpu); }
+
+    /**
+     * @description: 订阅负载类型T，收到对应evt_id的消息时调用handler
+     * @param {F} handler 形如 void(const T &) 或 void(const T &, const sEbusMsgItem_t &)
+     */
+    template <typename T, typename F>
+    void subscribe(F &&handler)
+    {
+        static_assert(Table::template IndexOf<T>() < Table::size, "payload type not in ebus event table");
+        static_assert(sizeof(T) <= MsgSize, "payload exceeds node MsgSize");
+        handlers_[Table::template IndexOf<T>()].template Bind<T>(std::forward<F>(handler));
+    }
+
+    /* 广播 */
+    template <typename T>
+    eEbusRst_t publish(const T &evt)
+    {
+        sEbusMsgItem_t msg;
+        Pack(msg, evt);
+        return EbusBroadcast(&node_, &msg);
+    }
+
+    /* 点对点通知，dst_id由EBUS_NODE_ID("name")得到 */
+    template <typename T>
+    eEbusRst_t notify(uint32_t dst_id, const T &evt)
+    {
+        sEbusMsgItem_t msg;
+        Pack(msg, evt);
+        return EbusNotificationById(&node_, dst_id, &msg);
+    }
+
+    /* 点对点指示，对端的响应经订阅的处理函数送达 */
+    template <typename T>
+    eEbusRst_t indicate(uint32_t dst_id, const T &evt)
+    {
+        sEbusMsgItem_t msg;
+        Pack(msg, evt);
+        return EbusIndicationAsyncById(&node_, dst_id, &msg);
+    }
+
+    /**
+     * @description: 响应当前正在处理的指示，只能在处理函数内调用
+     * @param {sEbusMsgItem_t} &req 处理函数收到的指示消息头
+     * @param {T} &evt 响应负载
+     */
+    template <typename T>
+    eEbusRst_t respond(const sEbusMsgItem_t &req, const T &evt)
+    {
+        if (ack_node_ == RT_NULL || req.type != eEbusMsgType_Indication)
+        {
+            return eEbusRst_ParamErr;
+        }
+        sEbusMsgItem_t msg;
+        Pack(msg, evt);
+        msg.seq_num = req.seq_num;
+        return EbusResponse(&node_, ack_node_, &msg);
+    }
+
+#if EBUS_HPP_COROUTINE
+    /**
+     * @description: 发送指示并挂起协程，应答到达或超时后在调用poll()的线程上恢复
+     * @param {uint32_t} dst_id 目标节点名称ID
+     * @param {T} &req 指示负载
+     * @param {rt_tick_t} timeout 应答超时(tick)，0使用EBUS_RESPONSE_WAIT_TIME_MS
+     * @return {*} co_await得到Reply<R>
+     */
+    template <typename R, typename T>
+    Request<Table, R> request(uint32_t dst_id, const T &req, rt_tick_t timeout = 0)
+    {
+        sEbusMsgItem_t msg;
+        Pack(msg, req);
+        return Request<Table, R>(&node_, dst_id, msg, timeout);
+    }
+#endif
+
+    /**
+     * @description: 接收一条消息并分发给订阅的处理函数，处理应答超时并恢复等待应答的协程
+     * @param {uint32_t} timeout 等待时间(tick)，有未完成的请求时不超过最早的应答超时时刻
+     * @return {*} 同EbusMsgWaitRecv
+     */
+    eEbusRst_t poll(uint32_t timeout = 0)
+    {
+        if (node_.wait_resp_timed != 0)
+        {
+            rt_int32_t left = (rt_int32_t)(node_.resp_deadline - rt_tick_get());
+            if (left < 0)
+            {
+                left = 0;
+            }
+            if ((uint32_t)left < timeout)
+            {
+                timeout = (uint32_t)left;
+            }
+        }
+
+        sEbusMsgItem_t msg;
+        eEbusRst_t rst = EbusMsgWaitRecv(&node_, &msg, timeout);
+        if (rst == eEbusRst_Success)
+        {
+            Dispatch(msg);
+        }
+        EbusWaitRespExpire(&node_);
+#if EBUS_HPP_COROUTINE
+        ResumeReady();
+#endif
+        return rst;
+    }
+
+private:
+    template <typename T>
+    static void Pack(sEbusMsgItem_t &msg, const T &evt)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "ebus payload must be trivially copyable");
+        static_assert(sizeof(T) <= EBUS_MAX_MSG_SIZE, "ebus payload exceeds EBUS_MAX_MSG_SIZE");
+        // 只填写负载，消息头由发送接口设置，队列只拷贝len字节
+        msg.evt_id = Table::template IdOf<T>();
+        msg.deadline = 0;
+        msg.ttl = 0;
+        msg.len = sizeof(T);
+        std::memcpy(msg.data, &evt, sizeof(T));
+    }
+
+    bool Dispatch(const sEbusMsgItem_t &msg)
+    {
+        int idx = Table::IndexOfId(msg.evt_id);
+        return (idx >= 0) && handlers_[idx].Call(msg);
+    }
+
+    // 指示和响应由EbusMsgWaitRecv经回调送达，node_为首成员，可直接还原出所属对象
+    static void Trampoline(eEbusEvtType_t evt, sEbusNode_t *node, sEbusMsgItem_t *msg, void *user_data)
+    {
+        static_assert(std::is_standard_layout<Node>::value, "ebus::Node must stay standard layout");
+        Node *self = reinterpret_cast<Node *>(node);
+        if (evt == eEBusEvtType_IndicationCb)
+        {
+            self->ack_node_ = static_cast<sEbusNode_t *>(user_data);
+            self->Dispatch(*msg);
+            self->ack_node_ = RT_NULL;
+            return;
+        }
+#if EBUS_HPP_COROUTINE
+        // 带上下文的应答/超时属于挂起的协程，等待项释放后再由poll()恢复
+        if (user_data != RT_NULL)
+        {
+            Pending *pending = static_cast<Pending *>(user_data);
+            pending->rst = (evt == eEBusEvtType_IndicationAckCb) ? eEbusRst_Success : eEbusRst_Timeout;
+            pending->msg = *msg;
+            pending->next = nullptr;
+            if (self->ready_tail_ != nullptr)
+            {
+                self->ready_tail_->next = pending;
+            }
+            else
+            {
+                self->ready_head_ = pending;
+            }
+            self->ready_tail_ = pending;
+            return;
+        }
+#endif
+        if (evt == eEBusEvtType_IndicationAckCb || evt == eEbusEvtType_RecvCb)
+        {
+            self->Dispatch(*msg);
+        }
+    }
+
+#if EBUS_HPP_COROUTINE
+    void ResumeReady()
+    {
+        Pending *pending = ready_head_;
+        ready_head_ = nullptr;
+        ready_tail_ = nullptr;
+        while (pending != nullptr)
+        {
+            // 恢复后协程帧可能被销毁，先取出后继
+            Pending *next = pending->next;
+            pending->handle.resume();
+            pending = next;
+        }
+    }
+#endif
+
+    sEbusNode_t node_;
+    eEbusRst_t rst_;
+    sEbusNode_t *ack_node_ = RT_NULL;
+#if EBUS_HPP_COROUTINE
+    Pending *ready_head_ = nullptr;
+    Pending *ready_tail_ = nullptr;
+#endif
+    Handler handlers_[Table::size];
+    alignas(RT_ALIGN_SIZE) rt_uint8_t pool_[EBUS_NODE_STORAGE_SIZE(MsgNum, MsgSize, RespNum)];
+};
+
+} // namespace ebus
+
+#endif
@@ -0,0 +1,638 @@
+/*
+ * 字节流桥：经UART、套接字等有序字节流连接两条总线。
+ * 帧格式：SOF(1) 负载长度(2) 帧序号(1) 负载 CRC16(2)，多字节字段均为小端。
+ * 负载由若干条消息记录组成：
+ *   描述(1) 事件id(2) 数据长度(1) [源节点ID(4)] [目标节点ID(4)] [截止时间(2)] [有效期(2)] 数据
+ * 描述字节低4位为消息类型，高4位标明后面4个可选字段是否存在，广播不带ID，最短记录只有4字节开销。
+ */
+#include "ebus_bridge.h"
+
+#define LOG_TAG "ebus_bridge"
+#define LOG_LVL LOG_LVL_INFO
+#include <ulog.h>
+
+#define EBUS_BRIDGE_REC_TYPE_MASK       (0x0F)
+#define EBUS_BRIDGE_REC_DEADLINE        (0x10)
+#define EBUS_BRIDGE_REC_TTL             (0x20)
+#define EBUS_BRIDGE_REC_SRC             (0x40)
+#define EBUS_BRIDGE_REC_DST             (0x80)
+#define EBUS_BRIDGE_REC_MIN_SIZE        (4)
+#define EBUS_BRIDGE_REC_MAX_SIZE        (EBUS_BRIDGE_REC_MIN_SIZE + 12 + EBUS_MAX_MSG_SIZE)
+
+/**
+ * @description: CRC16-CCITT(多项式0x1021，初值0xFFFF)
+ * @param {uint8_t} *data
+ * @param {rt_size_t} len
+ * @return {*}
+ */
+static uint16_t EbusBridgeCrc16(const uint8_t *data, rt_size_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (len--)
+    {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (int i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint8_t *EbusBridgePut16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *EbusBridgePut32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+static uint16_t EbusBridgeGet16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t EbusBridgeGet32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @description: 消息编码为记录，省略为0的可选字段
+ * @param {uint8_t} *rec 不小于EBUS_BRIDGE_REC_MAX_SIZE
+ * @param {uint32_t} src_id
+ * @param {uint32_t} dst_id 0表示对端广播投递
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*} 记录长度
+ */
+static uint16_t EbusBridgeEncode(uint8_t *rec, uint32_t src_id, uint32_t dst_id, const sEbusMsgItem_t *msg)
+{
+    uint8_t desc = (uint8_t)msg->type & EBUS_BRIDGE_REC_TYPE_MASK;
+    uint8_t *p = rec + 1;
+
+    p = EbusBridgePut16(p, msg->evt_id);
+    *p++ = msg->len;
+    if (src_id != 0)
+    {
+        desc |= EBUS_BRIDGE_REC_SRC;
+        p = EbusBridgePut32(p, src_id);
+    }
+    if (dst_id != 0)
+    {
+        desc |= EBUS_BRIDGE_REC_DST;
+        p = EbusBridgePut32(p, dst_id);
+    }
+    if (msg->deadline != 0)
+    {
+        desc |= EBUS_BRIDGE_REC_DEADLINE;
+        p = EbusBridgePut16(p, msg->deadline);
+    }
+    if (msg->ttl != 0)
+    {
+        desc |= EBUS_BRIDGE_REC_TTL;
+        p = EbusBridgePut16(p, msg->ttl);
+    }
+    rt_memcpy(p, msg->data, msg->len);
+    p += msg->len;
+    rec[0] = desc;
+    return (uint16_t)(p - rec);
+}
+
+/**
+ * @description: 记录写入发送帧缓冲，当前帧放不下时切换到另一帧并唤醒发送线程，不阻塞
+ * @param {sEbusBridge_t} *bridge
+ * @param {uint32_t} src_id
+ * @param {uint32_t} dst_id
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*} 两帧都未写出时返回-RT_EFULL
+ */
+static rt_err_t EbusBridgePut(sEbusBridge_t *bridge, uint32_t src_id, uint32_t dst_id, const sEbusMsgItem_t *msg)
+{
+    uint8_t rec[EBUS_BRIDGE_REC_MAX_SIZE];
+    uint16_t rec_len = EbusBridgeEncode(rec, src_id, dst_id, msg);
+    rt_bool_t wake = RT_FALSE;
+    rt_err_t result = RT_EOK;
+
+    rt_base_t level = rt_spin_lock_irqsave(&bridge->tx_lock);
+    sEbusBridgeFrame_t *frame = &bridge->frame[bridge->fill];
+    if (frame->len + rec_len > EBUS_BRIDGE_FRAME_SIZE)
+    {
+        // 另一帧已写出完毕才能切换，否则说明字节流跟不上
+        sEbusBridgeFrame_t *next = &bridge->frame[bridge->fill ^ 1];
+        frame = RT_NULL;
+        if (next->len == 0)
+        {
+            bridge->fill ^= 1;
+            frame = next;
+            wake = RT_TRUE;
+        }
+    }
+    if (frame != RT_NULL)
+    {
+        if (frame->len == 0)
+        {
+            frame->first = rt_tick_get();
+            wake = RT_TRUE;
+        }
+        rt_memcpy(&frame->buf[EBUS_BRIDGE_HEAD_SIZE + frame->len], rec, rec_len);
+        frame->len += rec_len;
+        frame->msg_cnt++;
+    }
+    else
+    {
+        bridge->stat.tx_drop_cnt++;
+        result = -RT_EFULL;
+    }
+    rt_spin_unlock_irqrestore(&bridge->tx_lock, level);
+
+    if (wake)
+    {
+        rt_sem_release(&bridge->tx_sem);
+    }
+    return result;
+}
+
+/**
+ * @description: 桥节点的传输端口，转发选定事件的广播
+ * @param {sEbusNode_t} *node 桥节点
+ * @param {uint32_t} src_node_id
+ * @param {sEbusMsgItem_t} *msg
+ * @param {void} *port_arg 所属的桥
+ * @return {*}
+ */
+static rt_err_t EbusBridgeNodePort(sEbusNode_t *node, uint32_t src_node_id, const sEbusMsgItem_t *msg, void *port_arg)
+{
+    sEbusBridge_t *bridge = (sEbusBridge_t *)port_arg;
+
+    if (msg->type != eEbusMsgType_Broadcast)
+    {
+        return (msg->type == eEbusMsgType_Indication || msg->type == eEbusMsgType_Response) ? -RT_EINVAL : RT_EOK;
+    }
+    rt_atomic_t evt_num = rt_atomic_load(&bridge->evt_num);
+    for (int i = 0; i < evt_num; i++)
+    {
+        if (bridge->evt_id[i] == msg->evt_id)
+        {
+            return EbusBridgePut(bridge, src_node_id, 0, msg);
+        }
+    }
+    return RT_EOK;
+}
+
+/**
+ * @description: 代理节点的传输端口，转发发给远端节点的通知和组播，广播由桥节点统一转发
+ * @param {sEbusNode_t} *node 代理节点
+ * @param {uint32_t} src_node_id
+ * @param {sEbusMsgItem_t} *msg
+ * @param {void} *port_arg 所属的桥
+ * @return {*}
+ */
+static rt_err_t EbusBridgeProxyPort(sEbusNode_t *node, uint32_t src_node_id, const sEbusMsgItem_t *msg, void *port_arg)
+{
+    if (msg->type == eEbusMsgType_Broadcast)
+    {
+        return RT_EOK;
+    }
+    if (msg->type != eEbusMsgType_Notification && msg->type != eEbusMsgType_Multicast)
+    {
+        return -RT_EINVAL;
+    }
+    return EbusBridgePut((sEbusBridge_t *)port_arg, src_node_id, node->name_hash, msg);
+}
+
+/**
+ * @description: 代理节点回调，代理节点不接收消息
+ * @return {*}
+ */
+static void EbusBridgeProxyCb(eEbusEvtType_t evt, sEbusNode_t *node, sEbusMsgItem_t *msg, void *user_data)
+{
+}
+
+/**
+ * @description: 补全帧头帧尾后写出，写出失败整帧丢弃
+ * @param {sEbusBridge_t} *bridge
+ * @param {sEbusBridgeFrame_t} *frame
+ * @return {*}
+ */
+static void EbusBridgeFlush(sEbusBridge_t *bridge, sEbusBridgeFrame_t *frame)
+{
+    uint8_t *buf = frame->buf;
+    rt_size_t total = EBUS_BRIDGE_HEAD_SIZE + frame->len + EBUS_BRIDGE_CRC_SIZE;
+
+    buf[0] = EBUS_BRIDGE_SOF;
+    EbusBridgePut16(&buf[1], frame->len);
+    buf[3] = bridge->tx_seq++;
+    EbusBridgePut16(&buf[EBUS_BRIDGE_HEAD_SIZE + frame->len], EbusBridgeCrc16(&buf[1], 3 + frame->len));
+
+    rt_size_t sent = 0;
+    while (sent < total)
+    {
+        rt_ssize_t n = bridge->write(bridge->io, &buf[sent], total - sent);
+        if (n <= 0)
+        {
+            break;
+        }
+        sent += n;
+    }
+
+    if (sent == total)
+    {
+        bridge->stat.tx_frame_cnt++;
+        bridge->stat.tx_msg_cnt += frame->msg_cnt;
+        bridge->stat.tx_byte_cnt += total;
+    }
+    else
+    {
+        LOG_W("[Ebus] bridge write failed, drop %d msg", frame->msg_cnt);
+        bridge->stat.tx_drop_cnt += frame->msg_cnt;
+    }
+}
+
+/**
+ * @description: 发送线程，写满的帧立即写出，未写满的帧到达发送时限后写出
+ * @param {void} *parameter 所属的桥
+ * @return {*}
+ */
+static void EbusBridgeTxEntry(void *parameter)
+{
+    sEbusBridge_t *bridge = (sEbusBridge_t *)parameter;
+    rt_int32_t wait = RT_WAITING_FOREVER;
+
+    while (1)
+    {
+        rt_sem_take(&bridge->tx_sem, wait);
+        if (!bridge->running)
+        {
+            break;
+        }
+
+        sEbusBridgeFrame_t *frame = RT_NULL;
+        wait = RT_WAITING_FOREVER;
+        rt_base_t level = rt_spin_lock_irqsave(&bridge->tx_lock);
+        sEbusBridgeFrame_t *cur = &bridge->frame[bridge->fill];
+        sEbusBridgeFrame_t *next = &bridge->frame[bridge->fill ^ 1];
+        if (next->len != 0)
+        {
+            // 端口已切换到另一帧，这一帧不会再被写入
+            frame = next;
+        }
+        else if (cur->len != 0)
+        {
+            rt_tick_t elapsed = rt_tick_get() - cur->first;
+            if (elapsed >= bridge->flush_tick)
+            {
+                frame = cur;
+                bridge->fill ^= 1;
+            }
+            else
+            {
+                wait = (rt_int32_t)(bridge->flush_tick - elapsed);
+            }
+        }
+        rt_spin_unlock_irqrestore(&bridge->tx_lock, level);
+
+        if (frame != RT_NULL)
+        {
+            EbusBridgeFlush(bridge, frame);
+            level = rt_spin_lock_irqsave(&bridge->tx_lock);
+            frame->len = 0;
+            frame->msg_cnt = 0;
+            // 写出期间可能又积累了消息，重新检查
+            wait = (bridge->frame[bridge->fill].len != 0) ? 0 : RT_WAITING_FOREVER;
+            rt_spin_unlock_irqrestore(&bridge->tx_lock, level);
+        }
+    }
+    rt_sem_release(&bridge->exit_sem);
+}
+
+/**
+ * @description: 创建字节流桥，桥节点和代理节点的消息合并成帧后由发送线程写出
+ * @param {char} *name 桥节点名称
+ * @param {EbusBridgeWritePtr} write 字节流写出，可阻塞，返回写出的字节数，<=0表示失败
+ * @param {void} *io 字节流句柄，原样传给write
+ * @param {uint16_t} flush_ms 发送时限，消息最多等待这么久与后续消息合并，0表示发送线程空闲即写出
+ * @return {*}
+ */
+sEbusBridge_t *EbusBridgeCreate(char *name, EbusBridgeWritePtr write, void *io, uint16_t flush_ms)
+{
+    if (name == RT_NULL || write == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    sEbusBridge_t *bridge = (sEbusBridge_t *)rt_malloc(sizeof(sEbusBridge_t));
+    if (bridge == RT_NULL)
+    {
+        return RT_NULL;
+    }
+    rt_memset(bridge, 0, sizeof(sEbusBridge_t));
+    bridge->write = write;
+    bridge->io = io;
+    bridge->flush_tick = rt_tick_from_millisecond(flush_ms);
+    rt_spin_lock_init(&bridge->tx_lock);
+
+    // 桥节点不入队，只需最小的队列
+    sEbusNodeCfg_t cfg = {1, EBUS_MAX_MSG_SIZE, 1};
+    bridge->node = EbusNodeCreateEx(name, EbusBridgeProxyCb, &cfg);
+    if (bridge->node == RT_NULL)
+    {
+        rt_free(bridge);
+        return RT_NULL;
+    }
+
+    rt_sem_init(&bridge->tx_sem, "ebbr", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&bridge->exit_sem, "ebbrx", 0, RT_IPC_FLAG_FIFO);
+    bridge->running = 1;
+    bridge->thread = rt_thread_create("ebbr", EbusBridgeTxEntry, bridge, EBUS_BRIDGE_THREAD_STACK_SIZE,
+                                      EBUS_BRIDGE_THREAD_PRIORITY, 10);
+    if (bridge->thread == RT_NULL)
+    {
+        rt_sem_detach(&bridge->tx_sem);
+        rt_sem_detach(&bridge->exit_sem);
+        EbusNodeDestory(bridge->node);
+        rt_free(bridge);
+        return RT_NULL;
+    }
+    EbusNodeSetPort(bridge->node, EbusBridgeNodePort, bridge);
+    rt_thread_startup(bridge->thread);
+    return bridge;
+}
+
+/**
+ * @description: 销毁字节流桥，未写出的消息丢弃
+ * @param {sEbusBridge_t} *bridge
+ * @return {*}
+ */
+void EbusBridgeDestory(sEbusBridge_t *bridge)
+{
+    if (bridge == RT_NULL)
+    {
+        return;
+    }
+
+    // 先删除节点，此后端口不再被调用
+    for (int i = 0; i < EBUS_BRIDGE_MAX_PROXY; i++)
+    {
+        if (bridge->proxy[i] != RT_NULL)
+        {
+            EbusNodeDestory(bridge->proxy[i]);
+        }
+    }
+    EbusNodeDestory(bridge->node);
+
+    bridge->running = 0;
+    rt_sem_release(&bridge->tx_sem);
+    rt_sem_take(&bridge->exit_sem, RT_WAITING_FOREVER);
+    rt_sem_detach(&bridge->tx_sem);
+    rt_sem_detach(&bridge->exit_sem);
+    rt_free(bridge);
+}
+
+/**
+ * @description: 添加镜像的广播事件，未添加任何事件时桥不转发广播；桥运行中也可添加
+ * @param {sEbusBridge_t} *bridge
+ * @param {uint16_t} evt_id
+ * @return {*}
+ */
+eEbusRst_t EbusBridgeEvtAdd(sEbusBridge_t *bridge, uint16_t evt_id)
+{
+    if (bridge == RT_NULL)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    // 添加方之间经tx_lock互斥；端口不取锁，事件先写入数组再发布数量
+    eEbusRst_t rst = eEbusRst_Success;
+    rt_base_t level = rt_spin_lock_irqsave(&bridge->tx_lock);
+    rt_atomic_t evt_num = rt_atomic_load(&bridge->evt_num);
+    int i;
+    for (i = 0; i < evt_num; i++)
+    {
+        if (bridge->evt_id[i] == evt_id)
+        {
+            break;
+        }
+    }
+    if (i == evt_num)
+    {
+        if (evt_num >= EBUS_BRIDGE_EVT_NUM)
+        {
+            rst = eEbusRst_NoMemory;
+        }
+        else
+        {
+            bridge->evt_id[evt_num] = evt_id;
+            rt_atomic_store(&bridge->evt_num, evt_num + 1);
+        }
+    }
+    rt_spin_unlock_irqrestore(&bridge->tx_lock, level);
+    return rst;
+}
+
+/**
+ * @description: 导入字节流对端的节点，在本地创建同名代理节点，发给代理的通知和组播经桥送达对端节点
+ * @param {sEbusBridge_t} *bridge
+ * @param {char} *name 对端节点名称
+ * @return {*} 代理节点，本地已有同名节点或代理数量已满时返回RT_NULL
+ */
+sEbusNode_t *EbusBridgeImport(sEbusBridge_t *bridge, char *name)
+{
+    if (bridge == RT_NULL || name == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    for (int i = 0; i < EBUS_BRIDGE_MAX_PROXY; i++)
+    {
+        if (bridge->proxy[i] == RT_NULL)
+        {
+            sEbusNodeCfg_t cfg = {1, EBUS_MAX_MSG_SIZE, 1};
+            sEbusNode_t *proxy = EbusNodeCreateEx(name, EbusBridgeProxyCb, &cfg);
+            if (proxy != RT_NULL)
+            {
+                EbusNodeSetPort(proxy, EbusBridgeProxyPort, bridge);
+                bridge->proxy[i] = proxy;
+            }
+            return proxy;
+        }
+    }
+    return RT_NULL;
+}
+
+/**
+ * @description: 查找对端节点在本地的代理，未导入时以桥节点为源
+ * @param {sEbusBridge_t} *bridge
+ * @param {uint32_t} src_id
+ * @return {*}
+ */
+static sEbusNode_t *EbusBridgeSrcNode(sEbusBridge_t *bridge, uint32_t src_id)
+{
+    for (int i = 0; src_id != 0 && i < EBUS_BRIDGE_MAX_PROXY; i++)
+    {
+        if (bridge->proxy[i] != RT_NULL && bridge->proxy[i]->name_hash == src_id)
+        {
+            return bridge->proxy[i];
+        }
+    }
+    return bridge->node;
+}
+
+/**
+ * @description: 解出一帧中的消息记录并按顺序注入本地总线
+ * @param {sEbusBridge_t} *bridge
+ * @param {uint8_t} *payload
+ * @param {uint16_t} len
+ * @return {*}
+ */
+static void EbusBridgeDeliver(sEbusBridge_t *bridge, const uint8_t *payload, uint16_t len)
+{
+    const uint8_t *p = payload;
+    const uint8_t *end = payload + len;
+
+    while (end - p >= EBUS_BRIDGE_REC_MIN_SIZE)
+    {
+        uint8_t desc = p[0];
+        sEbusMsgItem_t msg;
+        rt_memset(&msg, 0, EBUS_MSG_HEAD_SIZE);
+        msg.type = (eEbusMsgType_t)(desc & EBUS_BRIDGE_REC_TYPE_MASK);
+        msg.evt_id = EbusBridgeGet16(&p[1]);
+        msg.len = p[3];
+        p += EBUS_BRIDGE_REC_MIN_SIZE;
+
+        uint8_t opt_len = ((desc & EBUS_BRIDGE_REC_SRC) ? 4 : 0) + ((desc & EBUS_BRIDGE_REC_DST) ? 4 : 0) +
+                          ((desc & EBUS_BRIDGE_REC_DEADLINE) ? 2 : 0) + ((desc & EBUS_BRIDGE_REC_TTL) ? 2 : 0);
+        if (end - p < opt_len + msg.len || msg.len > EBUS_MAX_MSG_SIZE)
+        {
+            // 校验通过仍不合法，说明两端EBUS_MAX_MSG_SIZE不一致，丢弃帧的剩余部分
+            LOG_W("[Ebus] bridge %s bad record, evt=%x len=%d", bridge->node->name, msg.evt_id, msg.len);
+            return;
+        }
+
+        uint32_t src_id = 0;
+        uint32_t dst_id = 0;
+        if (desc & EBUS_BRIDGE_REC_SRC)
+        {
+            src_id = EbusBridgeGet32(p);
+            p += 4;
+        }
+        if (desc & EBUS_BRIDGE_REC_DST)
+        {
+            dst_id = EbusBridgeGet32(p);
+            p += 4;
+        }
+        if (desc & EBUS_BRIDGE_REC_DEADLINE)
+        {
+            msg.deadline = EbusBridgeGet16(p);
+            p += 2;
+        }
+        if (desc & EBUS_BRIDGE_REC_TTL)
+        {
+            msg.ttl = EbusBridgeGet16(p);
+            p += 2;
+        }
+        rt_memcpy(msg.data, p, msg.len);
+        p += msg.len;
+
+        bridge->stat.rx_msg_cnt++;
+        eEbusRst_t rst = EbusPortInject(EbusBridgeSrcNode(bridge, src_id), dst_id, &msg);
+        if (rst != eEbusRst_Success)
+        {
+            LOG_D("[Ebus] bridge %s deliver to 0x%08X failed: %d", bridge->node->name, dst_id, rst);
+        }
+    }
+}
+
+/**
+ * @description: 丢弃接收缓冲头部的字节
+ * @param {sEbusBridge_t} *bridge
+ * @param {uint16_t} n
+ * @return {*}
+ */
+static void EbusBridgeRxSkip(sEbusBridge_t *bridge, uint16_t n)
+{
+    bridge->rx_len -= n;
+    rt_memmove(bridge->rx_buf, &bridge->rx_buf[n], bridge->rx_len);
+}
+
+/**
+ * @description: 输入从字节流读到的数据，任意切分均可，完整的帧校验通过后立即注入本地总线；须由同一线程调用
+ * @param {sEbusBridge_t} *bridge
+ * @param {uint8_t} *data
+ * @param {rt_size_t} len
+ * @return {*}
+ */
+void EbusBridgeFeed(sEbusBridge_t *bridge, const uint8_t *data, rt_size_t len)
+{
+    if (bridge == RT_NULL || data == RT_NULL)
+    {
+        return;
+    }
+
+    while (len > 0)
+    {
+        rt_size_t n = sizeof(bridge->rx_buf) - bridge->rx_len;
+        n = (n < len) ? n : len;
+        rt_memcpy(&bridge->rx_buf[bridge->rx_len], data, n);
+        bridge->rx_len += n;
+        data += n;
+        len -= n;
+
+        while (1)
+        {
+            // 定位帧起始字节
+            uint16_t skip = 0;
+            while (skip < bridge->rx_len && bridge->rx_buf[skip] != EBUS_BRIDGE_SOF)
+            {
+                skip++;
+            }
+            if (skip != 0)
+            {
+                EbusBridgeRxSkip(bridge, skip);
+            }
+            if (bridge->rx_len < EBUS_BRIDGE_HEAD_SIZE)
+            {
+                break;
+            }
+
+            uint16_t payload_len = EbusBridgeGet16(&bridge->rx_buf[1]);
+            if (payload_len > EBUS_BRIDGE_FRAME_SIZE)
+            {
+                // 不是真正的帧头，从下一字节重新同步
+                EbusBridgeRxSkip(bridge, 1);
+                continue;
+            }
+            uint16_t frame_len = EBUS_BRIDGE_HEAD_SIZE + payload_len + EBUS_BRIDGE_CRC_SIZE;
+            if (bridge->rx_len < frame_len)
+            {
+                break;
+            }
+            if (EbusBridgeCrc16(&bridge->rx_buf[1], 3 + payload_len) !=
+                EbusBridgeGet16(&bridge->rx_buf[EBUS_BRIDGE_HEAD_SIZE + payload_len]))
+            {
+                bridge->stat.crc_err_cnt++;
+                EbusBridgeRxSkip(bridge, 1);
+                continue;
+            }
+
+            uint8_t seq = bridge->rx_buf[3];
+            if (bridge->rx_synced && seq != bridge->rx_seq)
+            {
+                bridge->stat.seq_gap_cnt += (uint8_t)(seq - bridge->rx_seq);
+            }
+            bridge->rx_synced = 1;
+            bridge->rx_seq = seq + 1;
+            bridge->stat.rx_frame_cnt++;
+            EbusBridgeDeliver(bridge, &bridge->rx_buf[EBUS_BRIDGE_HEAD_SIZE], payload_len);
+            EbusBridgeRxSkip(bridge, frame_len);
+        }
+    }
+}
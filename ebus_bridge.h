@@ -0,0 +1,100 @@
+#ifndef _EBUS_BRIDGE_H_
+#define _EBUS_BRIDGE_H_
+
+#include "ebus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef EBUS_BRIDGE_FRAME_SIZE
+#define EBUS_BRIDGE_FRAME_SIZE          (256)   //单帧最大负载长度，小消息在此范围内合并发送
+#endif
+#ifndef EBUS_BRIDGE_EVT_NUM
+#define EBUS_BRIDGE_EVT_NUM             (8)     //单个桥可镜像的广播事件数量
+#endif
+#ifndef EBUS_BRIDGE_MAX_PROXY
+#define EBUS_BRIDGE_MAX_PROXY           (8)     //单个桥可导入的远端节点数量
+#endif
+#ifndef EBUS_BRIDGE_THREAD_PRIORITY
+#define EBUS_BRIDGE_THREAD_PRIORITY     (12)    //发送线程优先级
+#endif
+#ifndef EBUS_BRIDGE_THREAD_STACK_SIZE
+#define EBUS_BRIDGE_THREAD_STACK_SIZE   (1024)  //发送线程栈大小
+#endif
+
+#define EBUS_BRIDGE_SOF                 (0xA5)  //帧起始字节
+#define EBUS_BRIDGE_HEAD_SIZE           (4)     //帧头：SOF(1) 负载长度(2) 帧序号(1)
+#define EBUS_BRIDGE_CRC_SIZE            (2)     //帧尾：CRC16-CCITT，覆盖负载长度、帧序号和负载
+#define EBUS_BRIDGE_BUF_SIZE            (EBUS_BRIDGE_HEAD_SIZE + EBUS_BRIDGE_FRAME_SIZE + EBUS_BRIDGE_CRC_SIZE)
+
+typedef rt_ssize_t (*EbusBridgeWritePtr)(void *io, const uint8_t *buf, rt_size_t len);
+
+/**
+ * @description: 发送帧缓冲，端口写入记录，发送线程加帧头帧尾后写出
+ */
+typedef struct sEbusBridgeFrameTag
+{
+    uint16_t len;                           //已写入的负载长度
+    uint16_t msg_cnt;                       //已合并的消息数量
+    rt_tick_t first;                        //第一条消息写入时刻，据此计算发送时限
+    uint8_t buf[EBUS_BRIDGE_BUF_SIZE];
+} sEbusBridgeFrame_t;
+
+/**
+ * @description: 桥统计
+ */
+typedef struct sEbusBridgeStatTag
+{
+    uint32_t tx_frame_cnt;                  //发送帧数量
+    uint32_t tx_msg_cnt;                    //发送消息数量
+    uint32_t tx_byte_cnt;                   //发送字节数量，含帧头帧尾
+    uint32_t tx_drop_cnt;                   //发送缓冲满或写出失败丢弃的消息数量
+    uint32_t rx_frame_cnt;                  //接收帧数量
+    uint32_t rx_msg_cnt;                    //接收消息数量
+    uint32_t crc_err_cnt;                   //校验失败丢弃的帧数量
+    uint32_t seq_gap_cnt;                   //按帧序号推算的丢失帧数量
+} sEbusBridgeStat_t;
+
+/**
+ * @description: 字节流桥，把本地总线延伸到UART、套接字等字节流另一端的总线
+ */
+typedef struct sEbusBridgeTag
+{
+    sEbusNode_t *node;                      //桥节点，收到的广播按事件选择后转发
+    EbusBridgeWritePtr write;               //字节流写出
+    void *io;                               //字节流句柄
+    rt_tick_t flush_tick;                   //发送时限，第一条消息等待合并的最长时间
+    volatile rt_atomic_t evt_num;           //镜像的广播事件数量，先写入evt_id再发布
+    uint16_t evt_id[EBUS_BRIDGE_EVT_NUM];   //镜像的广播事件
+    sEbusNode_t *proxy[EBUS_BRIDGE_MAX_PROXY];  //导入的远端节点在本地的代理
+    struct rt_spinlock tx_lock;             //发送帧缓冲锁，端口可能在中断中调用
+    uint8_t fill;                           //正在写入的帧缓冲
+    uint8_t tx_seq;                         //下一帧序号
+    sEbusBridgeFrame_t frame[2];            //双缓冲，一帧写出时另一帧继续合并
+    struct rt_semaphore tx_sem;             //唤醒发送线程
+    struct rt_semaphore exit_sem;           //发送线程退出通知
+    rt_thread_t thread;                     //发送线程
+    volatile uint8_t running;
+    uint8_t rx_synced;                      //是否已收到第一帧
+    uint8_t rx_seq;                         //期望的下一帧序号
+    uint16_t rx_len;                        //接收缓冲中的字节数
+    uint8_t rx_buf[EBUS_BRIDGE_BUF_SIZE];
+    sEbusBridgeStat_t stat;
+} sEbusBridge_t;
+
+sEbusBridge_t *EbusBridgeCreate(char *name, EbusBridgeWritePtr write, void *io, uint16_t flush_ms);
+
+void EbusBridgeDestory(sEbusBridge_t *bridge);
+
+eEbusRst_t EbusBridgeEvtAdd(sEbusBridge_t *bridge, uint16_t evt_id);
+
+sEbusNode_t *EbusBridgeImport(sEbusBridge_t *bridge, char *name);
+
+void EbusBridgeFeed(sEbusBridge_t *bridge, const uint8_t *data, rt_size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,702 @@
+/*
+ * 共享内存传输：节点接收环位于POSIX共享内存段中，同一主机上的多个Linux进程经此互发广播、组播和通知。
+ * 仅在定义EBUS_USING_SHM时编译，依赖shm_open/mmap/futex。
+ */
+#include "ebus_shm.h"
+
+#ifdef EBUS_USING_SHM
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#define LOG_TAG "ebus_shm"
+#define LOG_LVL LOG_LVL_INFO
+#include <ulog.h>
+
+#define EBUS_SHM_RING_MASK          (EBUS_SHM_RING_SIZE - 1)
+#define EBUS_SHM_PID_CLAIMING       (-1)    //进程槽位正在初始化，发送方视为不可用
+
+/* 共享段被多个进程同时访问，rt_atomic_*可能以关中断实现，这里直接使用编译器原子操作 */
+#define EBUS_SHM_LOAD(p)            __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define EBUS_SHM_STORE(p, v)        __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define EBUS_SHM_CAS(p, e, v)       __atomic_compare_exchange_n((p), (e), (v), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define EBUS_SHM_FENCE()            __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#define EBUS_SHM_CELL_STATE(seq, owner) (((uint64_t)(owner) << 32) | (uint32_t)(seq))
+#define EBUS_SHM_CELL_SEQ(state)        ((uint32_t)(state))
+#define EBUS_SHM_CELL_OWNER(state)      ((uint32_t)((state) >> 32))
+
+/**
+ * @description: 本进程的共享内存传输状态
+ */
+typedef struct sEbusShmTag
+{
+    uint8_t init;                           //是否已接入共享段
+    uint8_t proc_no;                        //本进程在共享段中的槽位
+    volatile uint8_t running;               //接收线程是否运行
+    int fd;                                 //共享内存文件
+    sEbusShmSeg_t *seg;                     //共享段映射
+    sEbusNode_t *node;                      //本进程的端口节点，未导入的远端节点发来的消息以其为源
+    rt_thread_t thread;                     //接收线程
+    struct rt_semaphore exit_sem;           //接收线程退出通知
+    sEbusNode_t *proxy[EBUS_SHM_MAX_NODE];  //导入的远端节点在本地的代理，按目录序号存放
+    int32_t proxy_pid[EBUS_SHM_MAX_NODE];   //创建代理时远端节点所属进程的pid
+    struct rt_mutex proxy_lock;             //代理表锁，接收线程以代理为源注入时不能销毁代理
+} sEbusShm_t;
+
+static sEbusShm_t g_ebus_shm_ = {0};
+
+/**
+ * @description: 进程是否已退出
+ * @param {int32_t} pid
+ * @return {*}
+ */
+static rt_bool_t EbusShmPidDead(int32_t pid)
+{
+    return (pid > 0 && kill(pid, 0) != 0 && errno == ESRCH) ? RT_TRUE : RT_FALSE;
+}
+
+/**
+ * @description: 复位进程接收环，调用者已占有该槽位
+ * @param {sEbusShmProc_t} *proc
+ * @return {*}
+ */
+static void EbusShmProcReset(sEbusShmProc_t *proc)
+{
+    for (uint32_t i = 0; i < EBUS_SHM_RING_SIZE; i++)
+    {
+        EBUS_SHM_STORE(&proc->cell[i].state, EBUS_SHM_CELL_STATE(i, 0));
+    }
+    EBUS_SHM_STORE(&proc->head, 0);
+    EBUS_SHM_STORE(&proc->tail, 0);
+    EBUS_SHM_STORE(&proc->sleeping, 0);
+    EBUS_SHM_STORE(&proc->drop_cnt, 0);
+}
+
+/**
+ * @description: 释放进程导出的全部节点
+ * @param {uint8_t} proc_no
+ * @return {*}
+ */
+static void EbusShmDirRelease(uint8_t proc_no)
+{
+    sEbusShmSeg_t *seg = g_ebus_shm_.seg;
+
+    for (int i = 0; i < EBUS_SHM_MAX_NODE; i++)
+    {
+        if (EBUS_SHM_LOAD(&seg->dir[i].state) == EBUS_SHM_DIR_VALID && seg->dir[i].proc_no == proc_no)
+        {
+            EBUS_SHM_STORE(&seg->dir[i].state, EBUS_SHM_DIR_FREE);
+        }
+    }
+}
+
+/**
+ * @description: 写入目标进程的接收环，多个进程可同时写入
+ * @param {uint8_t} proc_no 目标进程
+ * @param {uint32_t} src_id
+ * @param {uint32_t} dst_id
+ * @param {sEbusMsgItem_t} *msg
+ * @return {*} 接收环满返回RT_FALSE
+ */
+static rt_bool_t EbusShmPush(uint8_t proc_no, uint32_t src_id, uint32_t dst_id, const sEbusMsgItem_t *msg)
+{
+    sEbusShmProc_t *proc = &g_ebus_shm_.seg->proc[proc_no];
+    uint32_t owner = g_ebus_shm_.proc_no + 1;
+    uint32_t pos = EBUS_SHM_LOAD(&proc->head);
+
+    while (1)
+    {
+        sEbusShmCell_t *cell = &proc->cell[pos & EBUS_SHM_RING_MASK];
+        uint64_t state = EBUS_SHM_LOAD(&cell->state);
+        int32_t diff = (int32_t)(EBUS_SHM_CELL_SEQ(state) - pos);
+        if (diff < 0)
+        {
+            return RT_FALSE;
+        }
+        if (diff > 0)
+        {
+            pos = EBUS_SHM_LOAD(&proc->head);
+            continue;
+        }
+
+        // 序号与抢占者一起比较交换，单元只记录真正抢到它的进程，进程写完前退出时由其他进程据此补齐
+        uint32_t expect = pos;
+        if (EBUS_SHM_CELL_OWNER(state) == 0)
+        {
+            if (!EBUS_SHM_CAS(&cell->state, &state, EBUS_SHM_CELL_STATE(pos, owner)))
+            {
+                continue;
+            }
+            EBUS_SHM_CAS(&proc->head, &expect, pos + 1);
+            cell->src_id = src_id;
+            cell->dst_id = dst_id;
+            rt_memcpy(&cell->msg, msg, EBUS_MSG_ITEM_SIZE(msg->len));
+            EBUS_SHM_STORE(&cell->state, EBUS_SHM_CELL_STATE(pos + 1, owner));
+            return RT_TRUE;
+        }
+
+        // 单元已被抢占而入队位置未前移（抢占者尚未前移或已退出），代为前移后继续
+        EBUS_SHM_CAS(&proc->head, &expect, pos + 1);
+        pos = EBUS_SHM_LOAD(&proc->head);
+    }
+}
+
+/**
+ * @description: 接收环中是否有已写完的消息
+ * @param {sEbusShmProc_t} *proc
+ * @return {*}
+ */
+static rt_bool_t EbusShmPending(sEbusShmProc_t *proc)
+{
+    uint32_t pos = EBUS_SHM_LOAD(&proc->tail);
+
+    return EBUS_SHM_CELL_SEQ(EBUS_SHM_LOAD(&proc->cell[pos & EBUS_SHM_RING_MASK].state)) == pos + 1;
+}
+
+/**
+ * @description: 从本进程接收环取出一条消息，只由接收线程调用
+ * @param {sEbusShmProc_t} *proc
+ * @param {sEbusShmCell_t} *out
+ * @return {*}
+ */
+static rt_bool_t EbusShmPop(sEbusShmProc_t *proc, sEbusShmCell_t *out)
+{
+    uint32_t pos = EBUS_SHM_LOAD(&proc->tail);
+    sEbusShmCell_t *cell = &proc->cell[pos & EBUS_SHM_RING_MASK];
+
+    if (EBUS_SHM_CELL_SEQ(EBUS_SHM_LOAD(&cell->state)) != pos + 1)
+    {
+        return RT_FALSE;
+    }
+    out->src_id = cell->src_id;
+    out->dst_id = cell->dst_id;
+    rt_memcpy(&out->msg, &cell->msg, EBUS_MSG_ITEM_SIZE(cell->msg.len));
+    EBUS_SHM_STORE(&cell->state, EBUS_SHM_CELL_STATE(pos + EBUS_SHM_RING_SIZE, 0));
+    EBUS_SHM_STORE(&proc->tail, pos + 1);
+    return RT_TRUE;
+}
+
+/**
+ * @description: 接收线程已准备休眠时才唤醒，接收线程忙时发送不进入内核
+ * @param {sEbusShmProc_t} *proc
+ * @return {*}
+ */
+static void EbusShmWake(sEbusShmProc_t *proc)
+{
+    EBUS_SHM_FENCE();
+    if (EBUS_SHM_LOAD(&proc->sleeping))
+    {
+        __atomic_add_fetch(&proc->doorbell, 1, __ATOMIC_SEQ_CST);
+        syscall(SYS_futex, &proc->doorbell, FUTEX_WAKE, 1, RT_NULL, RT_NULL, 0);
+    }
+}
+
+/**
+ * @description: 补齐已退出进程抢占后未写完的单元，以空消息发布，否则目标接收环停在该单元
+ * @param {uint8_t} proc_no 已退出的进程，调用者已占住其槽位
+ * @return {*}
+ */
+static void EbusShmClaimRepair(uint8_t proc_no)
+{
+    sEbusShmSeg_t *seg = g_ebus_shm_.seg;
+    uint32_t owner = proc_no + 1;
+
+    for (uint8_t p = 0; p < EBUS_SHM_MAX_PROC; p++)
+    {
+        sEbusShmProc_t *proc = &seg->proc[p];
+        for (uint32_t i = 0; i < EBUS_SHM_RING_SIZE; i++)
+        {
+            // 序号仍是可写位置且抢占者为该进程，说明它抢到了单元但没有写完；已发布的单元序号为位置+1
+            sEbusShmCell_t *cell = &proc->cell[i];
+            uint64_t state = EBUS_SHM_LOAD(&cell->state);
+            uint32_t pos = EBUS_SHM_CELL_SEQ(state);
+            if (EBUS_SHM_CELL_OWNER(state) != owner || (pos & EBUS_SHM_RING_MASK) != i)
+            {
+                continue;
+            }
+            cell->dst_id = 0;
+            cell->msg.len = 0;
+            if (EBUS_SHM_CAS(&cell->state, &state, EBUS_SHM_CELL_STATE(pos + 1, owner)))
+            {
+                uint32_t expect = pos;
+                EBUS_SHM_CAS(&proc->head, &expect, pos + 1);
+                LOG_W("[Ebus] shm repaired cell %u of process %d left by process %d", pos, p, proc_no);
+                EbusShmWake(proc);
+            }
+        }
+    }
+}
+
+/**
+ * @description: 代理节点的传输端口，把消息写入远端节点所属进程的接收环
+ * @param {sEbusNode_t} *node 代理节点
+ * @param {uint32_t} src_node_id
+ * @param {sEbusMsgItem_t} *msg
+ * @param {void} *port_arg 远端节点的目录项
+ * @return {*}
+ */
+static rt_err_t EbusShmProxyPort(sEbusNode_t *node, uint32_t src_node_id, const sEbusMsgItem_t *msg, void *port_arg)
+{
+    sEbusShmDir_t *dir = (sEbusShmDir_t *)port_arg;
+
+    // 指示需要在请求方登记等待项，跨进程只传递广播、组播和通知
+    if (msg->type == eEbusMsgType_Indication || msg->type == eEbusMsgType_Response)
+    {
+        return -RT_EINVAL;
+    }
+    if (EBUS_SHM_LOAD(&dir->state) != EBUS_SHM_DIR_VALID || dir->name_hash != node->name_hash)
+    {
+        return -RT_ERROR;
+    }
+
+    sEbusShmProc_t *proc = &g_ebus_shm_.seg->proc[dir->proc_no];
+    if (EBUS_SHM_LOAD(&proc->pid) <= 0)
+    {
+        return -RT_ERROR;
+    }
+    if (!EbusShmPush(dir->proc_no, src_node_id, dir->name_hash, msg))
+    {
+        __atomic_add_fetch(&proc->drop_cnt, 1, __ATOMIC_RELAXED);
+        return -RT_EFULL;
+    }
+    EbusShmWake(proc);
+    return RT_EOK;
+}
+
+/**
+ * @description: 本进程端口节点的传输端口，发给它的消息直接丢弃
+ * @return {*}
+ */
+static rt_err_t EbusShmSelfPort(sEbusNode_t *node, uint32_t src_node_id, const sEbusMsgItem_t *msg, void *port_arg)
+{
+    return RT_EOK;
+}
+
+/**
+ * @description: 代理节点回调，代理节点不接收消息
+ * @return {*}
+ */
+static void EbusShmProxyCb(eEbusEvtType_t evt, sEbusNode_t *node, sEbusMsgItem_t *msg, void *user_data)
+{
+}
+
+/**
+ * @description: 检查其他进程是否存活，回收已退出进程的槽位和导出的节点，补齐其未写完的单元
+ * @return {*}
+ */
+static void EbusShmCheckPeers(void)
+{
+    sEbusShmSeg_t *seg = g_ebus_shm_.seg;
+
+    for (uint8_t p = 0; p < EBUS_SHM_MAX_PROC; p++)
+    {
+        int32_t pid = EBUS_SHM_LOAD(&seg->proc[p].pid);
+        if (p == g_ebus_shm_.proc_no || !EbusShmPidDead(pid))
+        {
+            continue;
+        }
+        // 占住槽位后由本进程独自回收，代理节点随即返回失败，摘除目录项后再释放槽位
+        if (EBUS_SHM_CAS(&seg->proc[p].pid, &pid, EBUS_SHM_PID_CLAIMING))
+        {
+            EbusShmDirRelease(p);
+            EbusShmClaimRepair(p);
+            EBUS_SHM_STORE(&seg->proc[p].pid, 0);
+            LOG_W("[Ebus] shm peer %d (pid %d) exited, drops %d", p, pid, seg->proc[p].drop_cnt);
+        }
+    }
+}
+
+/**
+ * @description: 查找远端节点在本地的代理，未导入时返回本进程端口节点，调用者持有代理表锁
+ * @param {uint32_t} src_id
+ * @return {*}
+ */
+static sEbusNode_t *EbusShmSrcNode(uint32_t src_id)
+{
+    for (int i = 0; src_id != 0 && i < EBUS_SHM_MAX_NODE; i++)
+    {
+        if (g_ebus_shm_.proxy[i] != RT_NULL && g_ebus_shm_.proxy[i]->name_hash == src_id)
+        {
+            return g_ebus_shm_.proxy[i];
+        }
+    }
+    return g_ebus_shm_.node;
+}
+
+/**
+ * @description: 接收线程，把其他进程写入的消息注入本地总线；空闲时先空转，再在futex上休眠
+ * @param {void} *parameter
+ * @return {*}
+ */
+static void EbusShmRecvEntry(void *parameter)
+{
+    sEbusShmProc_t *proc = &g_ebus_shm_.seg->proc[g_ebus_shm_.proc_no];
+    rt_tick_t check_tick = rt_tick_get();
+    sEbusShmCell_t cell;
+    int idle = 0;
+
+    while (g_ebus_shm_.running)
+    {
+        if (EbusShmPop(proc, &cell))
+        {
+            idle = 0;
+            if (cell.dst_id == 0)
+            {
+                // 已退出的发送方留下的空单元
+                continue;
+            }
+            rt_mutex_take(&g_ebus_shm_.proxy_lock, RT_WAITING_FOREVER);
+            eEbusRst_t rst = EbusPortInject(EbusShmSrcNode(cell.src_id), cell.dst_id, &cell.msg);
+            rt_mutex_release(&g_ebus_shm_.proxy_lock);
+            if (rst != eEbusRst_Success)
+            {
+                LOG_D("[Ebus] shm deliver to 0x%08X failed: %d", cell.dst_id, rst);
+            }
+            continue;
+        }
+
+        if (++idle < EBUS_SHM_SPIN)
+        {
+            rt_thread_yield();
+            continue;
+        }
+        idle = 0;
+
+        // 先声明休眠再复查接收环，发送方在写入后检查sleeping，两侧之间有完整屏障
+        uint32_t bell = EBUS_SHM_LOAD(&proc->doorbell);
+        EBUS_SHM_STORE(&proc->sleeping, 1);
+        EBUS_SHM_FENCE();
+        if (!EbusShmPending(proc) && g_ebus_shm_.running)
+        {
+            struct timespec ts = {EBUS_SHM_CHECK_MS / 1000, (EBUS_SHM_CHECK_MS % 1000) * 1000000L};
+            syscall(SYS_futex, &proc->doorbell, FUTEX_WAIT, bell, &ts, RT_NULL, 0);
+        }
+        EBUS_SHM_STORE(&proc->sleeping, 0);
+
+        if (rt_tick_get() - check_tick >= rt_tick_from_millisecond(EBUS_SHM_CHECK_MS))
+        {
+            check_tick = rt_tick_get();
+            EbusShmCheckPeers();
+        }
+    }
+    rt_sem_release(&g_ebus_shm_.exit_sem);
+}
+
+/**
+ * @description: 映射共享段，首个进程负责初始化
+ * @param {char} *shm_name 共享内存名称，如"/ebus"
+ * @return {*}
+ */
+static eEbusRst_t EbusShmMap(const char *shm_name)
+{
+    int fd = shm_open(shm_name, O_CREAT | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        LOG_E("[Ebus] shm_open %s failed: %d", shm_name, errno);
+        return eEbusRst_Fail;
+    }
+    // 新建的共享内存由内核清零，init为0
+    if (ftruncate(fd, sizeof(sEbusShmSeg_t)) != 0)
+    {
+        LOG_E("[Ebus] shm resize failed: %d", errno);
+        close(fd);
+        return eEbusRst_Fail;
+    }
+    sEbusShmSeg_t *seg = mmap(RT_NULL, sizeof(sEbusShmSeg_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (seg == MAP_FAILED)
+    {
+        LOG_E("[Ebus] shm mmap failed: %d", errno);
+        close(fd);
+        return eEbusRst_Fail;
+    }
+
+    uint32_t state = 0;
+    if (EBUS_SHM_CAS(&seg->init, &state, 1))
+    {
+        seg->magic = EBUS_SHM_MAGIC;
+        seg->version = EBUS_SHM_VERSION;
+        seg->head_version = EBUS_MSG_HEAD_VERSION;
+        seg->msg_size = sizeof(sEbusMsgItem_t);
+        for (int p = 0; p < EBUS_SHM_MAX_PROC; p++)
+        {
+            EbusShmProcReset(&seg->proc[p]);
+        }
+        EBUS_SHM_STORE(&seg->init, 2);
+    }
+    else
+    {
+        for (int i = 0; i < 1000 && EBUS_SHM_LOAD(&seg->init) != 2; i++)
+        {
+            rt_thread_mdelay(1);
+        }
+    }
+
+    if (EBUS_SHM_LOAD(&seg->init) != 2 || seg->magic != EBUS_SHM_MAGIC || seg->version != EBUS_SHM_VERSION ||
+        seg->head_version != EBUS_MSG_HEAD_VERSION ||
+        seg->msg_size != sizeof(sEbusMsgItem_t))
+    {
+        LOG_E("[Ebus] shm %s layout mismatch", shm_name);
+        munmap(seg, sizeof(sEbusShmSeg_t));
+        close(fd);
+        return eEbusRst_ParamErr;
+    }
+
+    g_ebus_shm_.fd = fd;
+    g_ebus_shm_.seg = seg;
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 接入共享内存段，占用一个进程槽位并启动接收线程，需在EbusCreate之后调用
+ * @param {char} *shm_name 共享内存名称，同一名称的进程互相可见
+ * @return {*} 进程槽位已满返回eEbusRst_NoMemory
+ */
+eEbusRst_t EbusShmAttach(const char *shm_name)
+{
+    if (g_ebus_shm_.init || shm_name == RT_NULL)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    eEbusRst_t rst = EbusShmMap(shm_name);
+    if (rst != eEbusRst_Success)
+    {
+        return rst;
+    }
+
+    // 占用空闲槽位或已退出进程的槽位，复位接收环后再公布pid
+    sEbusShmSeg_t *seg = g_ebus_shm_.seg;
+    int proc_no = -1;
+    rt_bool_t dead = RT_FALSE;
+    for (int p = 0; p < EBUS_SHM_MAX_PROC && proc_no < 0; p++)
+    {
+        int32_t pid = EBUS_SHM_LOAD(&seg->proc[p].pid);
+        dead = EbusShmPidDead(pid);
+        if ((pid == 0 || dead) && EBUS_SHM_CAS(&seg->proc[p].pid, &pid, EBUS_SHM_PID_CLAIMING))
+        {
+            proc_no = p;
+        }
+    }
+    if (proc_no < 0)
+    {
+        LOG_E("[Ebus] shm %s has no free process slot", shm_name);
+        munmap(seg, sizeof(sEbusShmSeg_t));
+        close(g_ebus_shm_.fd);
+        return eEbusRst_NoMemory;
+    }
+    g_ebus_shm_.proc_no = (uint8_t)proc_no;
+    EbusShmDirRelease(g_ebus_shm_.proc_no);
+    if (dead)
+    {
+        EbusShmClaimRepair(g_ebus_shm_.proc_no);
+    }
+    EbusShmProcReset(&seg->proc[proc_no]);
+    EBUS_SHM_STORE(&seg->proc[proc_no].pid, (int32_t)getpid());
+
+    char name[EBUS_NAME_LEN];
+    rt_snprintf(name, sizeof(name), "shm%d", proc_no);
+    sEbusNodeCfg_t cfg = {1, EBUS_MAX_MSG_SIZE, 1};
+    g_ebus_shm_.node = EbusNodeCreateEx(name, EbusShmProxyCb, &cfg);
+    if (g_ebus_shm_.node == RT_NULL)
+    {
+        EBUS_SHM_STORE(&seg->proc[proc_no].pid, 0);
+        munmap(seg, sizeof(sEbusShmSeg_t));
+        close(g_ebus_shm_.fd);
+        return eEbusRst_NoMemory;
+    }
+    EbusNodeSetPort(g_ebus_shm_.node, EbusShmSelfPort, RT_NULL);
+
+    rt_mutex_init(&g_ebus_shm_.proxy_lock, "ebshm", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&g_ebus_shm_.exit_sem, "ebshm", 0, RT_IPC_FLAG_FIFO);
+    g_ebus_shm_.running = 1;
+    g_ebus_shm_.thread = rt_thread_create("ebshm", EbusShmRecvEntry, RT_NULL, EBUS_SHM_THREAD_STACK_SIZE,
+                                          EBUS_SHM_THREAD_PRIORITY, 10);
+    if (g_ebus_shm_.thread == RT_NULL)
+    {
+        g_ebus_shm_.running = 0;
+        rt_sem_detach(&g_ebus_shm_.exit_sem);
+        rt_mutex_detach(&g_ebus_shm_.proxy_lock);
+        EbusNodeDestory(g_ebus_shm_.node);
+        EBUS_SHM_STORE(&seg->proc[proc_no].pid, 0);
+        munmap(seg, sizeof(sEbusShmSeg_t));
+        close(g_ebus_shm_.fd);
+        return eEbusRst_NoMemory;
+    }
+    g_ebus_shm_.init = 1;
+    rt_thread_startup(g_ebus_shm_.thread);
+
+    LOG_I("[Ebus] shm %s attached as process %d", shm_name, proc_no);
+    return eEbusRst_Success;
+}
+
+/**
+ * @description: 退出共享内存段，停止接收线程并删除本地代理节点，共享内存本身由部署者shm_unlink
+ * @return {*}
+ */
+void EbusShmDetach(void)
+{
+    if (!g_ebus_shm_.init)
+    {
+        return;
+    }
+
+    sEbusShmSeg_t *seg = g_ebus_shm_.seg;
+    sEbusShmProc_t *proc = &seg->proc[g_ebus_shm_.proc_no];
+
+    g_ebus_shm_.running = 0;
+    __atomic_add_fetch(&proc->doorbell, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, &proc->doorbell, FUTEX_WAKE, 1, RT_NULL, RT_NULL, 0);
+    rt_sem_take(&g_ebus_shm_.exit_sem, RT_WAITING_FOREVER);
+    rt_sem_detach(&g_ebus_shm_.exit_sem);
+
+    EbusShmDirRelease(g_ebus_shm_.proc_no);
+    EBUS_SHM_STORE(&proc->pid, 0);
+
+    for (int i = 0; i < EBUS_SHM_MAX_NODE; i++)
+    {
+        if (g_ebus_shm_.proxy[i] != RT_NULL)
+        {
+            EbusNodeDestory(g_ebus_shm_.proxy[i]);
+            g_ebus_shm_.proxy[i] = RT_NULL;
+        }
+    }
+    EbusNodeDestory(g_ebus_shm_.node);
+    g_ebus_shm_.node = RT_NULL;
+    rt_mutex_detach(&g_ebus_shm_.proxy_lock);
+
+    munmap(seg, sizeof(sEbusShmSeg_t));
+    close(g_ebus_shm_.fd);
+    g_ebus_shm_.seg = RT_NULL;
+    g_ebus_shm_.init = 0;
+}
+
+/**
+ * @description: 导出本地节点，其他进程导入后可向其发送广播、组播和通知
+ * @param {sEbusNode_t} *node
+ * @return {*} 同名节点已被导出返回eEbusRst_NameCollision
+ */
+eEbusRst_t EbusShmExport(sEbusNode_t *node)
+{
+    if (!g_ebus_shm_.init || node == RT_NULL || !node->init)
+    {
+        return eEbusRst_ParamErr;
+    }
+
+    sEbusShmSeg_t *seg = g_ebus_shm_.seg;
+    for (int i = 0; i < EBUS_SHM_MAX_NODE; i++)
+    {
+        if (EBUS_SHM_LOAD(&seg->dir[i].state) == EBUS_SHM_DIR_VALID && seg->dir[i].name_hash == node->name_hash)
+        {
+            return eEbusRst_NameCollision;
+        }
+    }
+
+    for (int i = 0; i < EBUS_SHM_MAX_NODE; i++)
+    {
+        uint32_t state = EBUS_SHM_DIR_FREE;
+        if (EBUS_SHM_CAS(&seg->dir[i].state, &state, EBUS_SHM_DIR_WRITING))
+        {
+            seg->dir[i].name_hash = node->name_hash;
+            seg->dir[i].proc_no = g_ebus_shm_.proc_no;
+            rt_strncpy(seg->dir[i].name, node->name, EBUS_NAME_LEN - 1);
+            seg->dir[i].name[EBUS_NAME_LEN - 1] = '\0';
+            EBUS_SHM_STORE(&seg->dir[i].state, EBUS_SHM_DIR_VALID);
+            return eEbusRst_Success;
+        }
+    }
+    return eEbusRst_NoMemory;
+}
+
+/**
+ * @description: 导入其他进程导出的节点，在本地创建同名代理节点，发给代理的消息写入对端进程；
+ *               对端重启后再次导入时销毁旧代理并重新创建，之前返回的代理随之失效
+ * @param {char} *name 远端节点名称
+ * @return {*} 代理节点，远端节点未导出或本地已有同名节点时返回RT_NULL
+ */
+sEbusNode_t *EbusShmImport(const char *name)
+{
+    if (!g_ebus_shm_.init || name == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    sEbusShmSeg_t *seg = g_ebus_shm_.seg;
+    sEbusNode_t *proxy = RT_NULL;
+    rt_mutex_take(&g_ebus_shm_.proxy_lock, RT_WAITING_FOREVER);
+    for (int i = 0; i < EBUS_SHM_MAX_NODE; i++)
+    {
+        sEbusShmDir_t *dir = &seg->dir[i];
+        if (EBUS_SHM_LOAD(&dir->state) != EBUS_SHM_DIR_VALID || dir->proc_no == g_ebus_shm_.proc_no ||
+            rt_strncmp(dir->name, name, EBUS_NAME_LEN) != 0)
+        {
+            continue;
+        }
+        int32_t pid = EBUS_SHM_LOAD(&seg->proc[dir->proc_no].pid);
+        if (pid <= 0)
+        {
+            continue;
+        }
+        if (g_ebus_shm_.proxy[i] != RT_NULL && g_ebus_shm_.proxy[i]->name_hash == dir->name_hash &&
+            g_ebus_shm_.proxy_pid[i] == pid)
+        {
+            proxy = g_ebus_shm_.proxy[i];
+            break;
+        }
+
+        // 对端进程已更换或导出到了其他目录项，旧的同名代理会造成名称冲突
+        for (int k = 0; k < EBUS_SHM_MAX_NODE; k++)
+        {
+            if (g_ebus_shm_.proxy[k] != RT_NULL && g_ebus_shm_.proxy[k]->name_hash == dir->name_hash)
+            {
+                EbusNodeDestory(g_ebus_shm_.proxy[k]);
+                g_ebus_shm_.proxy[k] = RT_NULL;
+            }
+        }
+
+        sEbusNodeCfg_t cfg = {1, EBUS_MAX_MSG_SIZE, 1};
+        proxy = EbusNodeCreateEx((char *)name, EbusShmProxyCb, &cfg);
+        if (proxy != RT_NULL)
+        {
+            EbusNodeSetPort(proxy, EbusShmProxyPort, dir);
+            g_ebus_shm_.proxy[i] = proxy;
+            g_ebus_shm_.proxy_pid[i] = pid;
+        }
+        break;
+    }
+    rt_mutex_release(&g_ebus_shm_.proxy_lock);
+    return proxy;
+}
+
+/**
+ * @description: 远端节点所属进程是否存活
+ * @param {uint32_t} node_id 节点名称ID EBUS_NODE_ID("name")
+ * @return {*}
+ */
+rt_bool_t EbusShmPeerAlive(uint32_t node_id)
+{
+    if (!g_ebus_shm_.init)
+    {
+        return RT_FALSE;
+    }
+
+    sEbusShmSeg_t *seg = g_ebus_shm_.seg;
+    for (int i = 0; i < EBUS_SHM_MAX_NODE; i++)
+    {
+        if (EBUS_SHM_LOAD(&seg->dir[i].state) == EBUS_SHM_DIR_VALID && seg->dir[i].name_hash == node_id)
+        {
+            int32_t pid = EBUS_SHM_LOAD(&seg->proc[seg->dir[i].proc_no].pid);
+            return (pid > 0 && !EbusShmPidDead(pid)) ? RT_TRUE : RT_FALSE;
+        }
+    }
+    return RT_FALSE;
+}
+
+#endif /* EBUS_USING_SHM */
@@ -0,0 +1,103 @@
+#ifndef _EBUS_SHM_H_
+#define _EBUS_SHM_H_
+
+#include "ebus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef EBUS_SHM_MAX_PROC
+#define EBUS_SHM_MAX_PROC           (8)     //共享段内的进程数量
+#endif
+#ifndef EBUS_SHM_MAX_NODE
+#define EBUS_SHM_MAX_NODE           (32)    //共享段内导出的节点数量
+#endif
+#ifndef EBUS_SHM_RING_SIZE
+#define EBUS_SHM_RING_SIZE          (64)    //每个进程的接收环容量，须为2的幂
+#endif
+#ifndef EBUS_SHM_SPIN
+#define EBUS_SHM_SPIN               (64)    //接收线程休眠前的空转次数
+#endif
+#ifndef EBUS_SHM_CHECK_MS
+#define EBUS_SHM_CHECK_MS           (100)   //检查对端进程存活的周期
+#endif
+#ifndef EBUS_SHM_THREAD_PRIORITY
+#define EBUS_SHM_THREAD_PRIORITY    (10)    //接收线程优先级
+#endif
+#ifndef EBUS_SHM_THREAD_STACK_SIZE
+#define EBUS_SHM_THREAD_STACK_SIZE  (2048)  //接收线程栈大小
+#endif
+
+#define EBUS_SHM_MAGIC              (0x45425348UL)  //"EBSH"
+#define EBUS_SHM_VERSION            (3)
+
+#define EBUS_SHM_DIR_FREE           (0)
+#define EBUS_SHM_DIR_WRITING        (1)
+#define EBUS_SHM_DIR_VALID          (2)
+
+/**
+ * @description: 进程接收环单元
+ */
+typedef struct sEbusShmCellTag
+{
+    volatile uint64_t state;                //低32位为单元序号，判断单元可写/可读；高32位为抢占该单元的进程槽位+1，0表示未被抢占
+    uint32_t src_id;                        //源节点名称ID，0表示源节点未在总线上注册
+    uint32_t dst_id;                        //目标节点名称ID
+    sEbusMsgItem_t msg;                     //消息
+} sEbusShmCell_t;
+
+/**
+ * @description: 共享段中的进程，多个进程无锁入队，本进程的接收线程出队
+ */
+typedef struct sEbusShmProcTag
+{
+    volatile int32_t pid;                   //所属进程，0表示空闲
+    volatile uint32_t head;                 //入队位置
+    volatile uint32_t tail;                 //出队位置
+    volatile uint32_t doorbell;             //唤醒计数，接收线程在此futex等待
+    volatile uint32_t sleeping;             //接收线程是否准备休眠，发送方据此决定是否唤醒
+    volatile uint32_t drop_cnt;             //接收环满丢弃的消息数量
+    sEbusShmCell_t cell[EBUS_SHM_RING_SIZE];
+} sEbusShmProc_t;
+
+/**
+ * @description: 共享段中导出的节点
+ */
+typedef struct sEbusShmDirTag
+{
+    volatile uint32_t state;                //EBUS_SHM_DIR_FREE/WRITING/VALID
+    uint32_t name_hash;                     //节点名称ID
+    uint8_t proc_no;                        //所属进程
+    char name[EBUS_NAME_LEN];               //节点名称
+} sEbusShmDir_t;
+
+/**
+ * @description: 共享段
+ */
+typedef struct sEbusShmSegTag
+{
+    volatile uint32_t init;                 //0未初始化 1初始化中 2已初始化
+    uint32_t magic;                         //EBUS_SHM_MAGIC
+    uint8_t version;                        //EBUS_SHM_VERSION
+    uint8_t head_version;                   //EBUS_MSG_HEAD_VERSION，接收环中的消息按原样拷贝
+    uint16_t msg_size;                      //sEbusMsgItem_t大小，各进程须一致
+    sEbusShmDir_t dir[EBUS_SHM_MAX_NODE];
+    sEbusShmProc_t proc[EBUS_SHM_MAX_PROC];
+} sEbusShmSeg_t;
+
+eEbusRst_t EbusShmAttach(const char *shm_name);
+
+void EbusShmDetach(void);
+
+eEbusRst_t EbusShmExport(sEbusNode_t *node);
+
+sEbusNode_t *EbusShmImport(const char *name);
+
+rt_bool_t EbusShmPeerAlive(uint32_t node_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,343 @@
+#include <stdlib.h>
+#include "ebus.h"
+
+#define LOG_TAG "ebus_bench_example"
+#define LOG_LVL LOG_LVL_INFO
+#include <ulog.h>
+
+#define THREAD_PRIORITY   25
+#define THREAD_STACK_SIZE 2048
+#define THREAD_TIMESLICE  5
+
+#define BENCH_MAX_THREAD  8
+#define BENCH_NODE_NUM    16
+#define BENCH_DURATION_MS 1000
+
+typedef struct sBenchWorkerTag
+{
+    int id;
+    uint32_t ops;
+} sBenchWorker_t;
+
+static volatile int g_bench_running = 0;
+static struct rt_semaphore g_bench_done;
+static sBenchWorker_t g_workers[BENCH_MAX_THREAD];
+static sEbusNode_t *g_bench_nodes[BENCH_NODE_NUM];
+static rt_atomic_t g_bench_handled = 0;
+static sEbusNode_t *g_pair_nodes[BENCH_MAX_THREAD * 2];
+
+static void BenchCb(eEbusEvtType_t evt, sEbusNode_t *node, sEbusMsgItem_t *msg, void *user_data)
+{
+    if (evt == eEbusEvtType_RecvCb)
+    {
+        rt_atomic_add(&g_bench_handled, 1);
+    }
+}
+
+static void lookup_thread_entry(void *parameter)
+{
+    sBenchWorker_t *worker = (sBenchWorker_t *)parameter;
+    char name[EBUS_NAME_LEN];
+    int i = worker->id;
+
+    while (g_bench_running)
+    {
+        rt_snprintf(name, sizeof(name), "bench%d", i % BENCH_NODE_NUM);
+        if (EbusNodeFind(name) != RT_NULL)
+        {
+            worker->ops++;
+        }
+        i++;
+    }
+    rt_sem_release(&g_bench_done);
+}
+
+/**
+ * @description: 多个线程并发按名称查找节点，统计总查找吞吐
+ * @param {int} thread_num
+ * @return {*} 每秒查找次数
+ */
+static uint32_t bench_lookup(int thread_num)
+{
+    g_bench_running = 1;
+    for (int i = 0; i < thread_num; i++)
+    {
+        g_workers[i].id = i;
+        g_workers[i].ops = 0;
+        rt_thread_t tid = rt_thread_create("bench",
+                                           lookup_thread_entry, &g_workers[i],
+                                           THREAD_STACK_SIZE,
+                                           THREAD_PRIORITY, THREAD_TIMESLICE);
+        if (tid != RT_NULL)
+            rt_thread_startup(tid);
+        else
+            rt_sem_release(&g_bench_done);
+    }
+
+    rt_thread_mdelay(BENCH_DURATION_MS);
+    g_bench_running = 0;
+
+    uint32_t total = 0;
+    for (int i = 0; i < thread_num; i++)
+    {
+        rt_sem_take(&g_bench_done, RT_WAITING_FOREVER);
+    }
+    for (int i = 0; i < thread_num; i++)
+    {
+        total += g_workers[i].ops;
+    }
+    return (uint32_t)((uint64_t)total * 1000 / BENCH_DURATION_MS);
+}
+
+static void send_thread_entry(void *parameter)
+{
+    sBenchWorker_t *worker = (sBenchWorker_t *)parameter;
+    sEbusMsgItem_t msg = { 0 };
+    char name[EBUS_NAME_LEN];
+    int i = worker->id;
+
+    msg.evt_id = 1;
+    msg.len = 1;
+    while (g_bench_running)
+    {
+        rt_snprintf(name, sizeof(name), "bench%d", 1 + i % (BENCH_NODE_NUM - 1));
+        if (EbusNotification(g_bench_nodes[0], name, &msg) == eEbusRst_Success)
+        {
+            worker->ops++;
+        }
+        else
+        {
+            rt_thread_yield();
+        }
+        i++;
+    }
+    rt_sem_release(&g_bench_done);
+}
+
+/**
+ * @description: 两个发送线程向全部节点发通知，由执行器处理，统计每秒处理的消息数
+ * @param {int} worker_num
+ * @return {*} 每秒处理消息数
+ */
+static uint32_t bench_exec(int worker_num)
+{
+    if (EbusExecCreate(worker_num) != eEbusRst_Success)
+    {
+        return 0;
+    }
+    for (int i = 1; i < BENCH_NODE_NUM; i++)
+    {
+        EbusExecAttach(g_bench_nodes[i]);
+    }
+
+    rt_atomic_store(&g_bench_handled, 0);
+    g_bench_running = 1;
+    for (int i = 0; i < 2; i++)
+    {
+        g_workers[i].id = i;
+        g_workers[i].ops = 0;
+        rt_thread_t tid = rt_thread_create("benchtx", send_thread_entry, &g_workers[i],
+                                           THREAD_STACK_SIZE, THREAD_PRIORITY, THREAD_TIMESLICE);
+        if (tid != RT_NULL)
+        {
+            rt_thread_startup(tid);
+        }
+        else
+        {
+            rt_sem_release(&g_bench_done);
+        }
+    }
+    rt_thread_mdelay(BENCH_DURATION_MS);
+    g_bench_running = 0;
+    for (int i = 0; i < 2; i++)
+    {
+        rt_sem_take(&g_bench_done, RT_WAITING_FOREVER);
+    }
+
+    uint32_t handled = (uint32_t)rt_atomic_load(&g_bench_handled);
+    EbusExecDestory();
+    for (int i = 1; i < BENCH_NODE_NUM; i++)
+    {
+        // 清空残留消息，下一轮重新计数
+        sEbusMsgItem_t msg;
+        while (EbusMsgRecv(g_bench_nodes[i], &msg) != eEbusRst_Timeout)
+        {
+        }
+    }
+    return (uint32_t)((uint64_t)handled * 1000 / BENCH_DURATION_MS);
+}
+
+/**
+ * @description: 单线程向全部节点广播后逐个取出，每次广播的拷贝量为消息长度乘以接收节点数
+ * @param {uint8_t} len 消息数据长度
+ * @return {*} 每秒广播次数
+ */
+static uint32_t bench_broadcast(uint8_t len)
+{
+    sEbusMsgItem_t msg = { 0 };
+    sEbusMsgItem_t rx_msg;
+    uint32_t ops = 0;
+
+    msg.evt_id = 1;
+    msg.len = len;
+    rt_tick_t start = rt_tick_get();
+    while (rt_tick_get() - start < rt_tick_from_millisecond(BENCH_DURATION_MS))
+    {
+        EbusBroadcast(g_bench_nodes[0], &msg);
+        for (int i = 1; i < BENCH_NODE_NUM; i++)
+        {
+            EbusMsgRecv(g_bench_nodes[i], &rx_msg);
+        }
+        ops++;
+    }
+    return (uint32_t)((uint64_t)ops * 1000 / BENCH_DURATION_MS);
+}
+
+static void PairCb(eEbusEvtType_t evt, sEbusNode_t *node, sEbusMsgItem_t *msg, void *user_data)
+{
+}
+
+static void pair_tx_thread_entry(void *parameter)
+{
+    sBenchWorker_t *worker = (sBenchWorker_t *)parameter;
+    sEbusNode_t *node = g_pair_nodes[worker->id * 2];
+    uint32_t dst_node_id = g_pair_nodes[worker->id * 2 + 1]->name_hash;
+    sEbusMsgItem_t msg = { 0 };
+
+    msg.evt_id = 1;
+    msg.len = 4;
+    while (g_bench_running)
+    {
+        if (EbusNotificationById(node, dst_node_id, &msg) == eEbusRst_Success)
+        {
+            worker->ops++;
+        }
+        else
+        {
+            rt_thread_yield();
+        }
+    }
+    rt_sem_release(&g_bench_done);
+}
+
+static void pair_rx_thread_entry(void *parameter)
+{
+    sBenchWorker_t *worker = (sBenchWorker_t *)parameter;
+    sEbusNode_t *node = g_pair_nodes[worker->id * 2 + 1];
+    sEbusMsgItem_t msg;
+
+    while (g_bench_running)
+    {
+        EbusMsgWaitRecv(node, &msg, 1);
+    }
+    rt_sem_release(&g_bench_done);
+}
+
+/**
+ * @description: 多对互不相关的收发线程，每对使用相邻创建的两个节点；跨核时发送与接收线程分别绑定到不同CPU，
+ *               本核时一对收发线程和两个节点都在同一CPU；节点之间或各核之间共享缓存行时吞吐不随对数增长
+ * @param {int} pair_num
+ * @param {rt_bool_t} local 收发线程是否在同一CPU
+ * @return {*} 每秒发送消息数
+ */
+static uint32_t bench_pair(int pair_num, rt_bool_t local)
+{
+    char name[EBUS_NAME_LEN];
+    for (int i = 0; i < pair_num * 2; i++)
+    {
+        rt_snprintf(name, sizeof(name), "pair%d", i);
+        g_pair_nodes[i] = EbusNodeCreate(name, PairCb);
+        if (local)
+        {
+            EbusNodeSetCpu(g_pair_nodes[i], (uint8_t)((i / 2) % EBUS_CPU_NUM));
+        }
+    }
+
+    g_bench_running = 1;
+    for (int i = 0; i < pair_num; i++)
+    {
+        g_workers[i].id = i;
+        g_workers[i].ops = 0;
+        rt_thread_t tx = rt_thread_create("benchptx", pair_tx_thread_entry, &g_workers[i],
+                                          THREAD_STACK_SIZE, THREAD_PRIORITY, THREAD_TIMESLICE);
+        rt_thread_t rx = rt_thread_create("benchprx", pair_rx_thread_entry, &g_workers[i],
+                                          THREAD_STACK_SIZE, THREAD_PRIORITY, THREAD_TIMESLICE);
+#ifdef RT_USING_SMP
+        rt_ubase_t tx_cpu = (rt_ubase_t)(local ? i : i * 2) % RT_CPUS_NR;
+        rt_ubase_t rx_cpu = local ? tx_cpu : (rt_ubase_t)(i * 2 + 1) % RT_CPUS_NR;
+        rt_thread_control(tx, RT_THREAD_CTRL_BIND_CPU, (void *)tx_cpu);
+        rt_thread_control(rx, RT_THREAD_CTRL_BIND_CPU, (void *)rx_cpu);
+#endif
+        rt_thread_startup(tx);
+        rt_thread_startup(rx);
+    }
+    rt_thread_mdelay(BENCH_DURATION_MS);
+    g_bench_running = 0;
+
+    uint64_t total = 0;
+    for (int i = 0; i < pair_num * 2; i++)
+    {
+        rt_sem_take(&g_bench_done, RT_WAITING_FOREVER);
+    }
+    for (int i = 0; i < pair_num; i++)
+    {
+        total += g_workers[i].ops;
+    }
+    for (int i = 0; i < pair_num * 2; i++)
+    {
+        EbusNodeDestory(g_pair_nodes[i]);
+    }
+    return (uint32_t)(total * 1000 / BENCH_DURATION_MS);
+}
+
+static void ebus_bench_example(int argc, char **argv)
+{
+    int max_thread = (argc > 1) ? atoi(argv[1]) : BENCH_MAX_THREAD;
+    if (max_thread < 1 || max_thread > BENCH_MAX_THREAD)
+    {
+        max_thread = BENCH_MAX_THREAD;
+    }
+
+    EbusCreate();
+    rt_sem_init(&g_bench_done, "benchsem", 0, RT_IPC_FLAG_FIFO);
+
+    char name[EBUS_NAME_LEN];
+    for (int i = 0; i < BENCH_NODE_NUM; i++)
+    {
+        rt_snprintf(name, sizeof(name), "bench%d", i);
+        g_bench_nodes[i] = EbusNodeCreate(name, BenchCb);
+    }
+
+    LOG_I("lookup bench: %d nodes, %d ms per round", BENCH_NODE_NUM, BENCH_DURATION_MS);
+    for (int n = 1; n <= max_thread; n *= 2)
+    {
+        LOG_I("  threads=%d lookups/s=%u", n, bench_lookup(n));
+    }
+
+    LOG_I("broadcast bench: %d receivers, header %d bytes", BENCH_NODE_NUM - 1, (int)EBUS_MSG_HEAD_SIZE);
+    for (int len = 1; len <= EBUS_MAX_MSG_SIZE; len *= 2)
+    {
+        LOG_I("  len=%d copy=%d bytes broadcasts/s=%u", len, (int)EBUS_MSG_ITEM_SIZE(len) * (BENCH_NODE_NUM - 1),
+              bench_broadcast((uint8_t)len));
+    }
+
+    LOG_I("pair bench: node size %d bytes", (int)sizeof(sEbusNode_t));
+    for (int n = 1; n <= max_thread; n *= 2)
+    {
+        uint32_t cross = bench_pair(n, RT_FALSE);
+        LOG_I("  pairs=%d cross-cpu msgs/s=%u same-cpu msgs/s=%u", n, cross, bench_pair(n, RT_TRUE));
+    }
+
+    LOG_I("exec bench: %d nodes, 2 senders", BENCH_NODE_NUM - 1);
+    for (int n = 1; n <= max_thread && n <= EBUS_EXEC_MAX_WORKER; n *= 2)
+    {
+        LOG_I("  workers=%d msgs/s=%u", n, bench_exec(n));
+    }
+
+    for (int i = 0; i < BENCH_NODE_NUM; i++)
+    {
+        EbusNodeDestory(g_bench_nodes[i]);
+    }
+    rt_sem_detach(&g_bench_done);
+}
+MSH_CMD_EXPORT(ebus_bench_example, ebus bench example: ebus_bench_example [max_threads]);
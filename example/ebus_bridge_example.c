@@ -0,0 +1,101 @@
+#include "ebus_bridge.h"
+
+#define LOG_TAG "ebus_bridge_example"
+#define LOG_LVL LOG_LVL_INFO
+#include <ulog.h>
+
+#define THREAD_PRIORITY   20
+#define THREAD_STACK_SIZE 2048
+#define THREAD_TIMESLICE  5
+
+#define BRIDGE_NAME       "Bridge"
+#define BRIDGE_FLUSH_MS   2
+
+typedef enum EbusEvtIdTag
+{
+    EbusEvtId_Status = 0x8201,
+}EbusEvtId_t;
+
+static sEbusBridge_t *g_bridge = RT_NULL;
+static struct rt_semaphore g_rx_sem;
+
+static rt_ssize_t UartWrite(void *io, const uint8_t *buf, rt_size_t len)
+{
+    return (rt_ssize_t)rt_device_write((rt_device_t)io, 0, buf, len);
+}
+
+static rt_err_t UartRxInd(rt_device_t dev, rt_size_t size)
+{
+    rt_sem_release(&g_rx_sem);
+    return RT_EOK;
+}
+
+static void uart_rx_thread_entry(void *parameter)
+{
+    rt_device_t dev = (rt_device_t)parameter;
+    uint8_t buf[64];
+
+    while (1)
+    {
+        rt_size_t len = rt_device_read(dev, 0, buf, sizeof(buf));
+        if (len == 0)
+        {
+            rt_sem_take(&g_rx_sem, RT_WAITING_FOREVER);
+            continue;
+        }
+        EbusBridgeFeed(g_bridge, buf, len);
+    }
+}
+
+static void ebus_bridge_example(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        rt_kprintf("usage: ebus_bridge_example <uart> [remote_node]\n");
+        return;
+    }
+    rt_device_t dev = rt_device_find(argv[1]);
+    if (dev == RT_NULL || rt_device_open(dev, RT_DEVICE_FLAG_INT_RX) != RT_EOK)
+    {
+        LOG_E("open %s failed", argv[1]);
+        return;
+    }
+
+    EbusCreate();
+    g_bridge = EbusBridgeCreate(BRIDGE_NAME, UartWrite, dev, BRIDGE_FLUSH_MS);
+    if (g_bridge == RT_NULL)
+    {
+        rt_device_close(dev);
+        return;
+    }
+    // 本地状态广播镜像到对端，发给对端节点的通知经代理转发
+    EbusBridgeEvtAdd(g_bridge, (uint16_t)EbusEvtId_Status);
+    if (argc > 2)
+    {
+        EbusBridgeImport(g_bridge, argv[2]);
+    }
+
+    rt_sem_init(&g_rx_sem, "ebbr_rx", 0, RT_IPC_FLAG_FIFO);
+    rt_device_set_rx_indicate(dev, UartRxInd);
+    rt_thread_t tid = rt_thread_create("ebbr_rx",
+                                       uart_rx_thread_entry, dev,
+                                       THREAD_STACK_SIZE,
+                                       THREAD_PRIORITY, THREAD_TIMESLICE);
+    if (tid != RT_NULL)
+        rt_thread_startup(tid);
+}
+MSH_CMD_EXPORT(ebus_bridge_example, ebus byte stream bridge example: uart remote_node);
+
+static void ebus_bridge_stat(void)
+{
+    if (g_bridge == RT_NULL)
+    {
+        return;
+    }
+    sEbusBridgeStat_t *stat = &g_bridge->stat;
+    rt_kprintf("tx frame:%u msg:%u byte:%u drop:%u\n", stat->tx_frame_cnt, stat->tx_msg_cnt, stat->tx_byte_cnt,
+               stat->tx_drop_cnt);
+    rt_kprintf("rx frame:%u msg:%u crc_err:%u seq_gap:%u\n", stat->rx_frame_cnt, stat->rx_msg_cnt,
+               stat->crc_err_cnt, stat->seq_gap_cnt);
+}
+MSH_CMD_EXPORT(ebus_bridge_stat, show ebus bridge statistics);
@@ -0,0 +1,263 @@
+#if defined(__linux__)
+// posix_openpt/ptsname/cfmakeraw需要在包含系统头文件之前声明
+#define _GNU_SOURCE
+#endif
+
+#include "ebus_bridge.h"
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define LOG_TAG "ebus_bridge_test"
+#define LOG_LVL LOG_LVL_INFO
+#include <ulog.h>
+
+#define THREAD_PRIORITY   20
+#define THREAD_STACK_SIZE 2048
+#define THREAD_TIMESLICE  5
+
+#define TEST_COUNT        2000          //发送的通知数量，每10条附带一次镜像广播
+#define TEST_TIMEOUT_MS   30000
+#define TEST_FLUSH_MS     5
+#define TEST_QUEUE_NUM    64            //节点队列深度
+#define TEST_BATCH        8             //每批发送后让出1ms，桥两端没有流控，接收方队列满时丢弃
+
+/*
+ * 字节流桥回环测试，经pty连接同一主机上的两个进程：
+ *   进程1: ebus_bridge_test a b           创建pty主端并打印从端路径
+ *   进程2: ebus_bridge_test b a <从端路径>
+ * 两端互发通知和镜像广播，检查通知有序、带EBUS_MSG_FLAG_REMOTE且没有CRC错误和丢帧，
+ * 结束时打印帧统计，tx msg/tx frame即每帧合并的消息数。
+ */
+
+typedef enum EbusEvtIdTag
+{
+    EbusEvtId_BridgeNotify = 0x8202,
+    EbusEvtId_BridgeStatus = 0x8203,
+}EbusEvtId_t;
+
+static char g_self_name[EBUS_NAME_LEN];
+static char g_peer_name[EBUS_NAME_LEN];
+static int g_fd = -1;
+static sEbusBridge_t *g_bridge = RT_NULL;
+static rt_bool_t g_synced;
+static uint16_t g_expect;
+static uint32_t g_disorder;
+static uint32_t g_bcast;
+static volatile rt_bool_t g_done;
+
+static rt_ssize_t PtyWrite(void *io, const uint8_t *buf, rt_size_t len)
+{
+    return (rt_ssize_t)write(*(int *)io, buf, len);
+}
+
+static void BridgeTestCb(eEbusEvtType_t evt, sEbusNode_t *node, sEbusMsgItem_t *msg, void *user_data)
+{
+    if (evt != eEbusEvtType_RecvCb || !(msg->flag & EBUS_MSG_FLAG_REMOTE))
+    {
+        return;
+    }
+    if (msg->evt_id == EbusEvtId_BridgeStatus)
+    {
+        g_bcast++;
+        return;
+    }
+    if (msg->evt_id != EbusEvtId_BridgeNotify || msg->len < 2)
+    {
+        return;
+    }
+
+    // 对端可能先于本进程接入，从收到的第一条开始检查
+    uint16_t cnt = (uint16_t)(msg->data[0] | (msg->data[1] << 8));
+    if (!g_synced)
+    {
+        g_synced = RT_TRUE;
+        g_expect = cnt;
+    }
+    if (cnt != g_expect)
+    {
+        g_disorder++;
+        LOG_W("expect %d got %d", g_expect, cnt);
+    }
+    g_expect = cnt + 1;
+    if (cnt == TEST_COUNT - 1)
+    {
+        g_done = RT_TRUE;
+    }
+}
+
+static void bridge_rx_thread_entry(void *parameter)
+{
+    uint8_t buf[97];
+
+    while (1)
+    {
+        ssize_t len = read(g_fd, buf, sizeof(buf));
+        if (len <= 0)
+        {
+            break;
+        }
+        EbusBridgeFeed(g_bridge, buf, (rt_size_t)len);
+    }
+}
+
+static void bridge_test_entry(void *parameter)
+{
+    sEbusNodeCfg_t cfg = {TEST_QUEUE_NUM, 0, 0};
+    sEbusNode_t *node = EbusNodeCreateEx(g_self_name, BridgeTestCb, &cfg);
+    if (node == RT_NULL || EbusBridgeImport(g_bridge, g_peer_name) == RT_NULL)
+    {
+        LOG_E("ebus_bridge_test FAIL: create node");
+        return;
+    }
+
+    sEbusMsgItem_t tx_msg;
+    sEbusMsgItem_t rx_msg;
+    rt_memset(&tx_msg, 0, sizeof(tx_msg));
+
+    uint16_t sent = 0;
+    rt_tick_t start = rt_tick_get();
+    while (rt_tick_get() - start < rt_tick_from_millisecond(TEST_TIMEOUT_MS) && !(g_done && sent == TEST_COUNT))
+    {
+        if (sent < TEST_COUNT)
+        {
+            tx_msg.evt_id = (uint16_t)EbusEvtId_BridgeNotify;
+            tx_msg.len = 2;
+            tx_msg.data[0] = (uint8_t)sent;
+            tx_msg.data[1] = (uint8_t)(sent >> 8);
+            if (EbusNotification(node, g_peer_name, &tx_msg) == eEbusRst_Success)
+            {
+                sent++;
+                if (sent % 10 == 0)
+                {
+                    tx_msg.evt_id = (uint16_t)EbusEvtId_BridgeStatus;
+                    tx_msg.len = 1;
+                    EbusBroadcast(node, &tx_msg);
+                }
+                if (sent % TEST_BATCH == 0)
+                {
+                    rt_thread_mdelay(1);
+                }
+            }
+            else
+            {
+                // 两帧都未写出，等待发送线程
+                rt_thread_mdelay(1);
+            }
+        }
+
+        eEbusRst_t rst = EbusMsgRecv(node, &rx_msg);
+        while (rst == eEbusRst_Success)
+        {
+            node->Evtcb(eEbusEvtType_RecvCb, node, &rx_msg, NULL);
+            rst = EbusMsgRecv(node, &rx_msg);
+        }
+        if (sent == TEST_COUNT)
+        {
+            rt_thread_mdelay(1);
+        }
+    }
+    // 留出时间让对端收完
+    rt_thread_mdelay(500);
+
+    sEbusBridgeStat_t *stat = &g_bridge->stat;
+    rt_bool_t pass = g_done && g_disorder == 0 && stat->crc_err_cnt == 0 && stat->seq_gap_cnt == 0;
+    LOG_I("ebus_bridge_test %s: sent %d recv %d disorder %d bcast %d", pass ? "PASS" : "FAIL",
+          sent, g_expect, g_disorder, g_bcast);
+    rt_kprintf("tx frame:%u msg:%u byte:%u drop:%u\n", stat->tx_frame_cnt, stat->tx_msg_cnt, stat->tx_byte_cnt,
+               stat->tx_drop_cnt);
+    rt_kprintf("rx frame:%u msg:%u crc_err:%u seq_gap:%u\n", stat->rx_frame_cnt, stat->rx_msg_cnt,
+               stat->crc_err_cnt, stat->seq_gap_cnt);
+}
+
+/**
+ * @description: 打开pty主端或按路径打开从端，切换为原始模式，避免行规程改写字节
+ * @param {char} *path 从端路径，RT_NULL表示创建主端
+ * @return {*}
+ */
+static int bridge_test_open(const char *path)
+{
+    int fd;
+
+    if (path == RT_NULL)
+    {
+        fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0)
+        {
+            return -1;
+        }
+        rt_kprintf("ebus_bridge_test pty: %s\n", ptsname(fd));
+    }
+    else
+    {
+        fd = open(path, O_RDWR | O_NOCTTY);
+        if (fd < 0)
+        {
+            return -1;
+        }
+    }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+static void ebus_bridge_test(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        rt_kprintf("usage: ebus_bridge_test <self> <peer> [pty]\n");
+        return;
+    }
+    rt_strncpy(g_self_name, argv[1], EBUS_NAME_LEN - 1);
+    rt_strncpy(g_peer_name, argv[2], EBUS_NAME_LEN - 1);
+    g_synced = RT_FALSE;
+    g_expect = 0;
+    g_disorder = 0;
+    g_bcast = 0;
+    g_done = RT_FALSE;
+
+    g_fd = bridge_test_open(argc > 3 ? argv[3] : RT_NULL);
+    if (g_fd < 0)
+    {
+        LOG_E("open pty failed");
+        return;
+    }
+
+    EbusCreate();
+    char name[EBUS_NAME_LEN];
+    // 节点名称不超过EBUS_NAME_LEN - 1，截短自身名称为前缀留出位置
+    rt_snprintf(name, sizeof(name), "br_%.*s", EBUS_NAME_LEN - 4, g_self_name);
+    g_bridge = EbusBridgeCreate(name, PtyWrite, &g_fd, TEST_FLUSH_MS);
+    if (g_bridge == RT_NULL)
+    {
+        close(g_fd);
+        return;
+    }
+    EbusBridgeEvtAdd(g_bridge, (uint16_t)EbusEvtId_BridgeStatus);
+
+    rt_thread_t tid = rt_thread_create("ebbr_rx",
+                                       bridge_rx_thread_entry, RT_NULL,
+                                       THREAD_STACK_SIZE,
+                                       THREAD_PRIORITY, THREAD_TIMESLICE);
+    if (tid != RT_NULL)
+        rt_thread_startup(tid);
+
+    tid = rt_thread_create("ebbr_test",
+                           bridge_test_entry, RT_NULL,
+                           THREAD_STACK_SIZE,
+                           THREAD_PRIORITY + 1, THREAD_TIMESLICE);
+    if (tid != RT_NULL)
+        rt_thread_startup(tid);
+}
+MSH_CMD_EXPORT(ebus_bridge_test, ebus bridge pty loopback test: self peer [pty]);
+
+#endif /* __linux__ */
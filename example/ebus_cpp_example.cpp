@@ -0,0 +1,83 @@
+#include "ebus.hpp"
+
+#define LOG_TAG "ebus_cpp_example"
+#define LOG_LVL LOG_LVL_INFO
+#include <ulog.h>
+
+#define NODE_SENSOR_NAME "Sensor"
+#define NODE_CTRL_NAME   "Ctrl"
+
+struct Temp
+{
+    int16_t centi;
+    uint8_t channel;
+};
+
+struct Calib
+{
+    uint8_t channel;
+    int8_t offset;
+};
+
+struct CalibAck
+{
+    uint8_t channel;
+    uint8_t ok;
+};
+
+typedef ebus::EvtTable<ebus::Evt<0x9001, Temp>,
+                       ebus::Evt<0x9002, Calib>,
+                       ebus::Evt<0x9003, CalibAck>>
+    Events;
+
+typedef ebus::Node<Events, 4, sizeof(Temp), 2> ExampleNode;
+
+#if EBUS_HPP_COROUTINE
+static ebus::Task calib_query(ExampleNode &ctrl)
+{
+    auto reply = co_await ctrl.request<CalibAck>(EBUS_NODE_ID(NODE_SENSOR_NAME), Calib{2, 5}, 100);
+    if (reply)
+    {
+        LOG_I("ctrl co_await calib ack ch%d ok=%d", reply.value.channel, reply.value.ok);
+    }
+    else
+    {
+        LOG_W("ctrl co_await calib failed %d", reply.rst);
+    }
+}
+#endif
+
+static void ebus_cpp_example(void)
+{
+    ebus::Bus bus;
+    ExampleNode sensor(NODE_SENSOR_NAME);
+    ExampleNode ctrl(NODE_CTRL_NAME);
+
+    if (sensor.status() != eEbusRst_Success || ctrl.status() != eEbusRst_Success)
+    {
+        LOG_E("node init failed");
+        return;
+    }
+
+    ctrl.subscribe<Temp>([](const Temp &t) {
+        LOG_I("ctrl recv temp ch%d %d", t.channel, t.centi);
+    });
+    ctrl.subscribe<CalibAck>([](const CalibAck &ack) {
+        LOG_I("ctrl recv calib ack ch%d ok=%d", ack.channel, ack.ok);
+    });
+    sensor.subscribe<Calib>([&sensor](const Calib &c, const sEbusMsgItem_t &req) {
+        LOG_I("sensor calib ch%d offset %d", c.channel, c.offset);
+        sensor.respond(req, CalibAck{c.channel, 1});
+    });
+
+    sensor.notify(EBUS_NODE_ID(NODE_CTRL_NAME), Temp{2512, 1});
+    ctrl.indicate(EBUS_NODE_ID(NODE_SENSOR_NAME), Calib{1, -3});
+#if EBUS_HPP_COROUTINE
+    calib_query(ctrl);
+#endif
+
+    while (ctrl.poll() != eEbusRst_Timeout || sensor.poll() != eEbusRst_Timeout)
+    {
+    }
+}
+MSH_CMD_EXPORT(ebus_cpp_example, ebus cpp example);
@@ -0,0 +1,105 @@
+#include "ebus_shm.h"
+
+#ifdef EBUS_USING_SHM
+
+#define LOG_TAG "ebus_shm_example"
+#define LOG_LVL LOG_LVL_INFO
+#include <ulog.h>
+
+#define THREAD_PRIORITY   25
+#define THREAD_STACK_SIZE 2048
+#define THREAD_TIMESLICE  5
+
+#define SHM_NAME          "/ebus"
+#define SEND_COUNT        100
+
+typedef enum EbusEvtIdTag
+{
+    EbusEvtId_Ping = 0x8101,
+}EbusEvtId_t;
+
+static char g_self_name[EBUS_NAME_LEN];
+static char g_peer_name[EBUS_NAME_LEN];
+
+static void ShmNodeCb(eEbusEvtType_t evt, sEbusNode_t *node, sEbusMsgItem_t *msg, void *user_data)
+{
+    LOG_I("recv node name:%s evt:%x seq:%u data:%d", node->name, msg->evt_id, msg->seq_num, msg->data[0]);
+}
+
+static void shm_thread_entry(void *parameter)
+{
+    sEbusNode_t *node = EbusNodeCreate(g_self_name, ShmNodeCb);
+    if (node == RT_NULL)
+    {
+        return;
+    }
+    EbusShmExport(node);
+
+    // 对端进程可能晚于本进程启动，等待其导出节点
+    sEbusNode_t *peer = RT_NULL;
+    for (int i = 0; i < 100 && peer == RT_NULL; i++)
+    {
+        peer = EbusShmImport(g_peer_name);
+        rt_thread_mdelay(100);
+    }
+    if (peer == RT_NULL)
+    {
+        LOG_W("peer %s not found", g_peer_name);
+    }
+
+    sEbusMsgItem_t tx_msg;
+    sEbusMsgItem_t rx_msg;
+    rt_memset(&tx_msg, 0, sizeof(tx_msg));
+    tx_msg.evt_id = (uint16_t)EbusEvtId_Ping;
+    tx_msg.len = 1;
+    for (int i = 0; i < SEND_COUNT; i++)
+    {
+        if (peer != RT_NULL)
+        {
+            tx_msg.data[0] = (uint8_t)i;
+            eEbusRst_t result = EbusNotification(node, g_peer_name, &tx_msg);
+            if (result != eEbusRst_Success)
+            {
+                LOG_W("send to %s failed: %d alive:%d", g_peer_name, result,
+                      EbusShmPeerAlive(peer->name_hash));
+            }
+        }
+        eEbusRst_t rst = EbusMsgRecv(node, &rx_msg);
+        while (rst == eEbusRst_Success)
+        {
+            node->Evtcb(eEbusEvtType_RecvCb, node, &rx_msg, NULL);
+            rst = EbusMsgRecv(node, &rx_msg);
+        }
+        rt_thread_mdelay(100);
+    }
+
+    EbusShmDetach();
+    EbusNodeDestory(node);
+}
+
+static void ebus_shm_example(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        rt_kprintf("usage: ebus_shm_example <self> <peer>\n");
+        return;
+    }
+    rt_strncpy(g_self_name, argv[1], EBUS_NAME_LEN - 1);
+    rt_strncpy(g_peer_name, argv[2], EBUS_NAME_LEN - 1);
+
+    EbusCreate();
+    if (EbusShmAttach(SHM_NAME) != eEbusRst_Success)
+    {
+        return;
+    }
+
+    rt_thread_t tid = rt_thread_create("shm_ex",
+                                       shm_thread_entry, RT_NULL,
+                                       THREAD_STACK_SIZE,
+                                       THREAD_PRIORITY, THREAD_TIMESLICE);
+    if (tid != RT_NULL)
+        rt_thread_startup(tid);
+}
+MSH_CMD_EXPORT(ebus_shm_example, ebus shared memory example: self peer);
+
+#endif /* EBUS_USING_SHM */
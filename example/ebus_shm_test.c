@@ -0,0 +1,225 @@
+#include "ebus_shm.h"
+
+#ifdef EBUS_USING_SHM
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define LOG_TAG "ebus_shm_test"
+#define LOG_LVL LOG_LVL_INFO
+#include <ulog.h>
+
+#define THREAD_PRIORITY   25
+#define THREAD_STACK_SIZE 2048
+#define THREAD_TIMESLICE  5
+
+#define SHM_NAME          "/ebus_test"
+#define TEST_COUNT        2000          //每轮发送的通知数量
+#define TEST_TIMEOUT_MS   60000
+#define TEST_QUEUE_NUM    64            //节点队列深度
+#define TEST_BATCH        8             //每批发送后让出1ms，跨进程没有流控，接收方队列满时丢弃
+
+/*
+ * 多进程测试，在同一主机上的两个进程中分别执行：
+ *   进程1: ebus_shm_test a b
+ *   进程2: ebus_shm_test b a crash    发送一半后在进程1的接收环中抢占一个单元不写完即退出
+ *   进程2: ebus_shm_test b a          重启后从另一个目录项导出，重新发送一轮
+ * 进程1在收到重启后完整且有序的一轮通知时输出PASS。崩溃进程留下的单元由存活进程补齐，
+ * 否则进程1的接收环停在该单元；重启的对端换了进程和目录项，进程1重新导入后才能继续发送。
+ */
+
+typedef enum EbusEvtIdTag
+{
+    EbusEvtId_ShmTest = 0x8102,
+}EbusEvtId_t;
+
+static char g_self_name[EBUS_NAME_LEN];
+static char g_peer_name[EBUS_NAME_LEN];
+static rt_bool_t g_crash;
+static rt_bool_t g_synced;
+static uint16_t g_expect;
+static uint32_t g_disorder;
+static volatile rt_bool_t g_pass;
+
+static void ShmTestCb(eEbusEvtType_t evt, sEbusNode_t *node, sEbusMsgItem_t *msg, void *user_data)
+{
+    if (evt != eEbusEvtType_RecvCb || msg->evt_id != EbusEvtId_ShmTest || msg->len < 2)
+    {
+        return;
+    }
+
+    // 首条通知或计数归零（对端重启）时从该计数开始检查，对端重启前后本进程的计数连续
+    uint16_t cnt = (uint16_t)(msg->data[0] | (msg->data[1] << 8));
+    if (!g_synced || cnt == 0)
+    {
+        g_synced = RT_TRUE;
+        g_expect = cnt;
+    }
+    if (cnt != g_expect)
+    {
+        g_disorder++;
+        LOG_W("%s expect %d got %d", node->name, g_expect, cnt);
+    }
+    g_expect = cnt + 1;
+    if (cnt == TEST_COUNT - 1 && g_disorder == 0)
+    {
+        g_pass = RT_TRUE;
+    }
+}
+
+/**
+ * @description: 模拟发送方在抢占对端接收环单元之后、写完之前崩溃
+ * @return {*}
+ */
+static void ShmTestCrash(void)
+{
+    int fd = shm_open(SHM_NAME, O_RDWR, 0600);
+    sEbusShmSeg_t *seg = mmap(RT_NULL, sizeof(sEbusShmSeg_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (fd < 0 || seg == MAP_FAILED)
+    {
+        _exit(1);
+    }
+
+    int self = -1;
+    int peer = -1;
+    for (int p = 0; p < EBUS_SHM_MAX_PROC; p++)
+    {
+        if (seg->proc[p].pid == getpid())
+        {
+            self = p;
+        }
+    }
+    for (int i = 0; i < EBUS_SHM_MAX_NODE; i++)
+    {
+        if (seg->dir[i].state == EBUS_SHM_DIR_VALID && seg->dir[i].name_hash == EBUS_NODE_ID(g_peer_name))
+        {
+            peer = seg->dir[i].proc_no;
+        }
+    }
+    if (self >= 0 && peer >= 0)
+    {
+        // 与EbusShmPush相同，以序号和抢占者比较交换单元状态，不前移入队位置即退出
+        sEbusShmProc_t *proc = &seg->proc[peer];
+        uint32_t pos = __atomic_load_n(&proc->head, __ATOMIC_ACQUIRE);
+        sEbusShmCell_t *cell = &proc->cell[pos & (EBUS_SHM_RING_SIZE - 1)];
+        uint64_t state = pos;
+        if (__atomic_compare_exchange_n(&cell->state, &state, ((uint64_t)(self + 1) << 32) | pos, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            LOG_I("crash with cell %u of process %d claimed", pos, peer);
+        }
+    }
+    _exit(0);
+}
+
+static void shm_test_entry(void *parameter)
+{
+    sEbusNodeCfg_t cfg = {TEST_QUEUE_NUM, 0, 0};
+    sEbusNode_t *node = EbusNodeCreateEx(g_self_name, ShmTestCb, &cfg);
+    if (node == RT_NULL)
+    {
+        return;
+    }
+
+    // 崩溃的一轮先多导出一个节点，重启后本节点落在另一个目录项
+    sEbusNode_t *pad = RT_NULL;
+    if (g_crash)
+    {
+        char name[EBUS_NAME_LEN];
+        // 节点名称不超过EBUS_NAME_LEN - 1，截短自身名称为后缀留出位置
+        rt_snprintf(name, sizeof(name), "%.*s_pad", EBUS_NAME_LEN - 5, g_self_name);
+        pad = EbusNodeCreate(name, ShmTestCb);
+        EbusShmExport(pad);
+    }
+    EbusShmExport(node);
+
+    sEbusMsgItem_t tx_msg;
+    sEbusMsgItem_t rx_msg;
+    rt_memset(&tx_msg, 0, sizeof(tx_msg));
+    tx_msg.evt_id = (uint16_t)EbusEvtId_ShmTest;
+    tx_msg.len = 2;
+
+    uint16_t sent = 0;
+    rt_tick_t start = rt_tick_get();
+    while (rt_tick_get() - start < rt_tick_from_millisecond(TEST_TIMEOUT_MS) && !(g_pass && sent == TEST_COUNT))
+    {
+        if (g_crash && sent == TEST_COUNT / 2)
+        {
+            ShmTestCrash();
+        }
+
+        // 对端未导出或已重启时重新导入，重启前的代理由导入销毁
+        if (sent < TEST_COUNT)
+        {
+            tx_msg.data[0] = (uint8_t)sent;
+            tx_msg.data[1] = (uint8_t)(sent >> 8);
+            if (EbusNotification(node, g_peer_name, &tx_msg) == eEbusRst_Success)
+            {
+                sent++;
+                if (sent % TEST_BATCH == 0)
+                {
+                    rt_thread_mdelay(1);
+                }
+            }
+            else
+            {
+                EbusShmImport(g_peer_name);
+                rt_thread_mdelay(1);
+            }
+        }
+
+        eEbusRst_t rst = EbusMsgRecv(node, &rx_msg);
+        while (rst == eEbusRst_Success)
+        {
+            node->Evtcb(eEbusEvtType_RecvCb, node, &rx_msg, NULL);
+            rst = EbusMsgRecv(node, &rx_msg);
+        }
+        if (sent == TEST_COUNT)
+        {
+            rt_thread_mdelay(1);
+        }
+    }
+
+    LOG_I("ebus_shm_test %s: sent %d recv %d disorder %d", g_pass ? "PASS" : "FAIL", sent, g_expect, g_disorder);
+    // 留出时间让对端收完再退出
+    rt_thread_mdelay(500);
+    EbusShmDetach();
+    EbusNodeDestory(node);
+    if (pad != RT_NULL)
+    {
+        EbusNodeDestory(pad);
+    }
+}
+
+static void ebus_shm_test(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        rt_kprintf("usage: ebus_shm_test <self> <peer> [crash]\n");
+        return;
+    }
+    rt_strncpy(g_self_name, argv[1], EBUS_NAME_LEN - 1);
+    rt_strncpy(g_peer_name, argv[2], EBUS_NAME_LEN - 1);
+    g_crash = (argc > 3 && rt_strcmp(argv[3], "crash") == 0) ? RT_TRUE : RT_FALSE;
+    g_synced = RT_FALSE;
+    g_expect = 0;
+    g_disorder = 0;
+    g_pass = RT_FALSE;
+
+    EbusCreate();
+    if (EbusShmAttach(SHM_NAME) != eEbusRst_Success)
+    {
+        return;
+    }
+
+    rt_thread_t tid = rt_thread_create("shm_test",
+                                       shm_test_entry, RT_NULL,
+                                       THREAD_STACK_SIZE,
+                                       THREAD_PRIORITY, THREAD_TIMESLICE);
+    if (tid != RT_NULL)
+        rt_thread_startup(tid);
+}
+MSH_CMD_EXPORT(ebus_shm_test, ebus shared memory multi-process test: self peer [crash]);
+
+#endif /* EBUS_USING_SHM */